@@ -30,6 +30,19 @@ float ADSR::process()
     return value;
 }
 
+void ADSR::advance (int numSamples)
+{
+    if (! adsr.isActive())
+        return;
+
+    float value = latestValue.load (std::memory_order_relaxed);
+
+    for (int i = 0; i < numSamples; ++i)
+        value = adsr.getNextSample();
+
+    latestValue.store (value, std::memory_order_relaxed);
+}
+
 void ADSR::setParameters (const ADSRParameters& params)
 {
     juce::ADSR::Parameters adsrParams;
@@ -26,6 +26,9 @@ public:
     void prepareToPlay (double sampleRate) override;
     float process() override;
 
+    /** Moves the envelope on by numSamples without producing its values. */
+    void advance (int numSamples);
+
     void setParameters (const ADSRParameters& params);
 
     void applyEnvelopeToBuffer (juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    BitmapDataManager.cpp
+    Created: 24 May 2024 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "BitmapDataManager.h"
+
+BitmapDataManager::Snapshot::Snapshot (const juce::Image& sourceImage, const HighPrecisionImage* preciseImage,
+                                       const BrightnessPyramid::ProgressCallback& progressCallback)
+    : image (sourceImage),
+      pyramid (sourceImage, preciseImage, progressCallback)
+{
+}
+
+BitmapDataManager::Snapshot::Snapshot (const juce::Image& previewImage, std::unique_ptr<TerrainFile> terrainFile)
+    : image (previewImage),
+      pyramid (std::move (terrainFile))
+{
+}
+
+// ==============================================================================
+BitmapDataManager::BitmapDataManager (ImageBuffer& bufferToFollow)
+    : imageBuffer (bufferToFollow)
+{
+    imageBuffer.addChangeListener (this);
+    updateBitmap();
+}
+
+BitmapDataManager::~BitmapDataManager()
+{
+    imageBuffer.removeChangeListener (this);
+    stopTimer();
+
+    // The audio callback has stopped by now, so nothing can still be reading.
+    jassert (activeReaders.load() == 0);
+    publishedSnapshot.store (nullptr);
+}
+
+void BitmapDataManager::changeListenerCallback (juce::ChangeBroadcaster* source)
+{
+    if (source == &imageBuffer)
+    {
+        updateBitmap();
+    }
+}
+
+void BitmapDataManager::updateBitmap()
+{
+    juce::Image newImage;
+    HighPrecisionImage::Ptr preciseImage;
+    imageBuffer.getContent (newImage, preciseImage);
+
+    // Both come from the same file, so the sizes only differ if a decoder disagrees with JUCE's.
+    if (preciseImage != nullptr && (preciseImage->getWidth() != newImage.getWidth() || preciseImage->getHeight() != newImage.getHeight()))
+        preciseImage = nullptr;
+
+    // Already published by whoever set the image
+    if (currentSnapshot != nullptr && currentSnapshot->image == newImage)
+        return;
+
+    if (newImage.isValid())
+        publish (new Snapshot (newImage, preciseImage.get()));
+    else
+        publish (nullptr);
+}
+
+void BitmapDataManager::publish (Snapshot::Ptr newSnapshot)
+{
+    publishedSnapshot.store (newSnapshot.get());
+
+    // A reader may still hold the old pointer, so keep it alive until the next
+    // time we see no reader active.
+    if (currentSnapshot != nullptr)
+        retiredSnapshots.add (currentSnapshot);
+
+    currentSnapshot = std::move (newSnapshot);
+
+    if (! retiredSnapshots.isEmpty())
+        startTimer (50);
+}
+
+void BitmapDataManager::timerCallback()
+{
+    // Any ScopedAccess started after the swap sees the new snapshot, so once the
+    // reader count has dropped to zero the retired ones are unreachable.
+    if (activeReaders.load() != 0)
+        return;
+
+    retiredSnapshots.clear();
+    stopTimer();
+}
+
+// ==============================================================================
+BitmapDataManager::ScopedAccess::ScopedAccess (BitmapDataManager& manager)
+    : owner (manager)
+{
+    owner.activeReaders.fetch_add (1);
+    snapshot = owner.publishedSnapshot.load();
+}
+
+BitmapDataManager::ScopedAccess::~ScopedAccess()
+{
+    owner.activeReaders.fetch_sub (1);
+}
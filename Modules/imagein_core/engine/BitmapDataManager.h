@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    BitmapDataManager.h
+    Created: 24 May 2024 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ImageBuffer.h"
+#include "BrightnessPyramid.h"
+
+/**
+    Publishes the BrightnessPyramid sampled by the readers without ever blocking
+    the audio thread.
+
+    It listens to an ImageBuffer and, on the message thread, builds an immutable
+    Snapshot of the new image. The snapshot is swapped in through an atomic
+    pointer; the previous one is kept in a retire list and released by a timer
+    once no ScopedAccess can still be reading it. The audio thread therefore
+    never waits for a lock and never frees memory.
+*/
+class BitmapDataManager : private juce::ChangeListener,
+                          private juce::Timer
+{
+public:
+    BitmapDataManager (ImageBuffer& bufferToFollow);
+    ~BitmapDataManager() override;
+
+    /** An image and the brightness pyramid built from it, or from its high-precision
+        version when the file had one. Never modified once published.
+    */
+    struct Snapshot : public juce::ReferenceCountedObject
+    {
+        using Ptr = juce::ReferenceCountedObjectPtr<Snapshot>;
+
+        Snapshot (const juce::Image& sourceImage, const HighPrecisionImage* preciseImage,
+                  const BrightnessPyramid::ProgressCallback& progressCallback = {});
+
+        /** For a mapped terrain file; the image is only its preview. */
+        Snapshot (const juce::Image& previewImage, std::unique_ptr<TerrainFile> terrainFile);
+
+        const juce::Image image;
+        const BrightnessPyramid pyramid;
+
+        JUCE_DECLARE_NON_COPYABLE (Snapshot)
+    };
+
+    // Provides wait-free, RAII-style access to the current pyramid.
+    // Keep it alive only for the duration of a block.
+    class ScopedAccess
+    {
+    public:
+        ScopedAccess (BitmapDataManager& manager);
+        ~ScopedAccess();
+        const BrightnessPyramid* operator->() const { return get(); }
+        const BrightnessPyramid* get() const { return snapshot != nullptr ? &snapshot->pyramid : nullptr; }
+
+    private:
+        BitmapDataManager& owner;
+        const Snapshot* snapshot;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAccess)
+    };
+
+    /** Returns the current snapshot. Message thread only. */
+    Snapshot::Ptr getSnapshot() const { return currentSnapshot; }
+
+    /** Publishes a snapshot built elsewhere, e.g. by ImageLoader. Message thread only.
+        When the ImageBuffer then changes to the snapshot's image, it isn't rebuilt.
+    */
+    void publishSnapshot (Snapshot::Ptr newSnapshot) { publish (std::move (newSnapshot)); }
+
+private:
+    void changeListenerCallback (juce::ChangeBroadcaster* source) override;
+    void timerCallback() override;
+    void updateBitmap();
+    void publish (Snapshot::Ptr newSnapshot);
+
+    ImageBuffer& imageBuffer;
+
+    // Owned by the message thread; the audio thread only sees the raw pointer below.
+    Snapshot::Ptr currentSnapshot;
+    std::atomic<Snapshot*> publishedSnapshot { nullptr };
+    std::atomic<int> activeReaders { 0 };
+
+    juce::ReferenceCountedArray<Snapshot> retiredSnapshots;
+};
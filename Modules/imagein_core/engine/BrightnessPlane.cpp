@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    BrightnessPlane.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "BrightnessPlane.h"
+
+BrightnessPlane::BrightnessPlane (const juce::Image& image)
+{
+    if (! image.isValid())
+        return;
+
+    const juce::Image::BitmapData bitmapData (image, juce::Image::BitmapData::readOnly);
+    auto* dest = allocate (bitmapData.width, bitmapData.height);
+
+    const bool singleChannel = bitmapData.pixelFormat == juce::Image::SingleChannel;
+
+    for (int y = 0; y < height; ++y)
+    {
+        auto* line = dest + (size_t) y * (size_t) lineStride;
+
+        for (int x = 0; x < width; ++x)
+        {
+            auto* p = bitmapData.getPixelPointer (x, y);
+            const auto brightness = singleChannel ? p[0] : juce::jmax (p[0], p[1], p[2]);
+            line[x] = (float) brightness * (2.0f / 255.0f) - 1.0f;
+        }
+    }
+}
+
+BrightnessPlane::BrightnessPlane (const HighPrecisionImage& image)
+{
+    auto* dest = allocate (image.getWidth(), image.getHeight());
+
+    for (int y = 0; y < height; ++y)
+    {
+        const auto* src = image.getLinePointer (y);
+        auto* line = dest + (size_t) y * (size_t) lineStride;
+
+        for (int x = 0; x < width; ++x)
+            line[x] = src[x] * 2.0f - 1.0f;
+    }
+}
+
+BrightnessPlane::BrightnessPlane (const float* externalData, int w, int h, int stride, Layout newLayout)
+    : data (externalData), width (w), height (h), lineStride (stride), layout (newLayout)
+{
+    if (layout == Layout::tiled)
+        tilesPerRow = (width + tileSize - 1) / tileSize;
+}
+
+BrightnessPlane BrightnessPlane::createHalfSize (const BrightnessPlane& source)
+{
+    BrightnessPlane half;
+
+    if (source.data == nullptr)
+        return half;
+
+    jassert (source.layout == Layout::rowMajor);
+
+    auto* dest = half.allocate ((source.width + 1) / 2, (source.height + 1) / 2);
+
+    for (int y = 0; y < half.height; ++y)
+    {
+        // Odd sizes repeat the last row/column of the source.
+        const float* src0 = source.getLinePointer (juce::jmin (2 * y, source.height - 1));
+        const float* src1 = source.getLinePointer (juce::jmin (2 * y + 1, source.height - 1));
+        auto* line = dest + (size_t) y * (size_t) half.lineStride;
+
+        for (int x = 0; x < half.width; ++x)
+        {
+            const int x0 = juce::jmin (2 * x, source.width - 1);
+            const int x1 = juce::jmin (2 * x + 1, source.width - 1);
+            line[x] = 0.25f * (src0[x0] + src0[x1] + src1[x0] + src1[x1]);
+        }
+    }
+
+    return half;
+}
+
+BrightnessPlane BrightnessPlane::createTiled (const BrightnessPlane& source)
+{
+    BrightnessPlane tiled;
+
+    if (source.data == nullptr)
+        return tiled;
+
+    jassert (source.layout == Layout::rowMajor);
+    auto* dest = tiled.allocateTiled (source.width, source.height);
+    const int tilesPerColumn = (source.height + tileSize - 1) / tileSize;
+
+    for (int ty = 0; ty < tilesPerColumn; ++ty)
+    {
+        for (int tx = 0; tx < tiled.tilesPerRow; ++tx)
+        {
+            auto* tile = dest + ((size_t) ty * (size_t) tiled.tilesPerRow + (size_t) tx) * (size_t) tileFloats;
+
+            // tileSize + 1 rows and columns: the last ones repeat the neighbours' first,
+            // or the image's last where there is no neighbour, as getInterpolated() clamps.
+            for (int ly = 0; ly <= tileSize; ++ly)
+            {
+                const float* line = source.getLinePointer (juce::jmin (ty * tileSize + ly, source.height - 1));
+
+                for (int lx = 0; lx <= tileSize; ++lx)
+                    tile[ly * tileStride + lx] = line[juce::jmin (tx * tileSize + lx, source.width - 1)];
+            }
+        }
+    }
+
+    return tiled;
+}
+
+float* BrightnessPlane::allocate (int newWidth, int newHeight)
+{
+    constexpr int floatsPerLine = (int) (alignmentBytes / sizeof (float));
+    width = newWidth;
+    height = newHeight;
+    lineStride = (width + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+
+    storage.allocate ((size_t) lineStride * (size_t) height + (size_t) floatsPerLine, true);
+    auto* dest = juce::snapPointerToAlignment (storage.get(), alignmentBytes);
+    data = dest;
+    return dest;
+}
+
+float* BrightnessPlane::allocateTiled (int newWidth, int newHeight)
+{
+    constexpr int floatsPerLine = (int) (alignmentBytes / sizeof (float));
+    width = newWidth;
+    height = newHeight;
+    lineStride = 0;
+    layout = Layout::tiled;
+    tilesPerRow = (width + tileSize - 1) / tileSize;
+
+    storage.allocate (getNumFloats (layout, width, height, lineStride) + (size_t) floatsPerLine, true);
+    auto* dest = juce::snapPointerToAlignment (storage.get(), alignmentBytes);
+    data = dest;
+    return dest;
+}
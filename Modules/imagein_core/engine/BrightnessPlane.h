@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    BrightnessPlane.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "HighPrecisionImage.h"
+
+/**
+    A single-channel float copy of an image's brightness, as seen by the readers.
+
+    Each pixel holds max(r, g, b) already mapped from [0, 255] to [-1, 1], so the
+    readers can interpolate it directly. The buffer is 64-byte aligned.
+
+    The samples are laid out in one of two ways:
+      - rowMajor: rows one after the other, each padded to whole cache lines.
+      - tiled: square tiles of tileSize pixels, one after the other, row by row.
+        Each tile also holds the first column and row of its neighbours, so all
+        four samples of a bilinear lookup are in the same tile. An ellipse that
+        runs vertically then changes page every tileSize rows instead of every
+        row, which saves TLB misses once rows are a few thousand pixels long.
+        Tiles take about a fifth more memory.
+*/
+class BrightnessPlane
+{
+public:
+    enum class Layout
+    {
+        rowMajor = 0,
+        tiled = 1
+    };
+
+    BrightnessPlane() = default;
+    explicit BrightnessPlane (const juce::Image& image);
+
+    /** Maps the image's [0, 1] brightness to [-1, 1] without going through 8 bits. */
+    explicit BrightnessPlane (const HighPrecisionImage& image);
+
+    /** A plane over samples it doesn't own, e.g. in a mapped TerrainFile. They must outlive it. */
+    BrightnessPlane (const float* externalData, int width, int height, int lineStride, Layout layout = Layout::rowMajor);
+
+    BrightnessPlane (BrightnessPlane&&) = default;
+    BrightnessPlane& operator= (BrightnessPlane&&) = default;
+
+    /** Returns a plane of half the size (rounded up), each value the mean of a 2x2 block. */
+    static BrightnessPlane createHalfSize (const BrightnessPlane& source);
+
+    /** Returns a copy of a rowMajor plane with the tiled layout. */
+    static BrightnessPlane createTiled (const BrightnessPlane& source);
+
+    /** The layout that samples fastest for an image of that size. */
+    static Layout getPreferredLayout (int imageWidth, int imageHeight) noexcept
+    {
+        return juce::jmax (imageWidth, imageHeight) >= minimumSizeForTiles ? Layout::tiled : Layout::rowMajor;
+    }
+
+    /** The number of floats a plane of that size and layout holds, padding included. */
+    static size_t getNumFloats (Layout layout, int width, int height, int lineStride) noexcept
+    {
+        if (layout == Layout::rowMajor)
+            return (size_t) lineStride * (size_t) height;
+
+        const auto tilesAcross = ((size_t) width + (size_t) tileSize - 1) / (size_t) tileSize;
+        const auto tilesDown = ((size_t) height + (size_t) tileSize - 1) / (size_t) tileSize;
+        return tilesAcross * tilesDown * (size_t) tileFloats;
+    }
+
+    size_t getSizeInBytes() const noexcept { return getNumFloats (layout, width, height, lineStride) * sizeof (float); }
+
+    bool isValid() const noexcept { return data != nullptr && width > 1 && height > 1; }
+
+    /** A row of a rowMajor plane. Tiled planes have no rows; use getValue() instead. */
+    const float* getLinePointer (int y) const noexcept
+    {
+        jassert (layout == Layout::rowMajor);
+        return data + (size_t) y * (size_t) lineStride;
+    }
+
+    float getValue (int x, int y) const noexcept { return data[getSampleIndex (x, y)]; }
+
+    /** Where the sample at (x, y) is in data. In a tiled plane, the one to its right
+        is always the next float and the one below it getRowStep() floats further,
+        even across tiles.
+    */
+    size_t getSampleIndex (int x, int y) const noexcept
+    {
+        if (layout == Layout::rowMajor)
+            return (size_t) y * (size_t) lineStride + (size_t) x;
+
+        const auto tx = (unsigned) x / (unsigned) tileSize, lx = (unsigned) x % (unsigned) tileSize;
+        const auto ty = (unsigned) y / (unsigned) tileSize, ly = (unsigned) y % (unsigned) tileSize;
+        return ((size_t) ty * (size_t) tilesPerRow + tx) * (size_t) tileFloats + ly * (unsigned) tileStride + lx;
+    }
+
+    int getRowStep() const noexcept { return layout == Layout::rowMajor ? lineStride : tileStride; }
+
+    /** Bilinear lookup. x and y are in pixels and must lie within [0, width - 1] and [0, height - 1]. */
+    float getInterpolated (float x, float y) const noexcept
+    {
+        const int ix = (int) x;
+        const int iy = (int) y;
+        const float fx = x - (float) ix;
+        const float fy = y - (float) iy;
+
+        if (layout == Layout::tiled)
+        {
+            // The right and bottom neighbours are in the tile's border, clamped at the image's edges.
+            const float* p = data + getSampleIndex (ix, iy);
+
+            const float top = p[0] + fx * (p[1] - p[0]);
+            const float bottom = p[tileStride] + fx * (p[tileStride + 1] - p[tileStride]);
+
+            return top + fy * (bottom - top);
+        }
+
+        const int ix1 = std::min (ix + 1, width - 1);
+        const int iy1 = std::min (iy + 1, height - 1);
+
+        const float* line0 = getLinePointer (iy);
+        const float* line1 = getLinePointer (iy1);
+
+        const float top = line0[ix] + fx * (line0[ix1] - line0[ix]);
+        const float bottom = line1[ix] + fx * (line1[ix1] - line1[ix]);
+
+        return top + fy * (bottom - top);
+    }
+
+    static constexpr size_t alignmentBytes = 64;
+
+    static constexpr int tileSize = 16;
+    static constexpr int tileStride = tileSize + 1; // in floats, with the neighbour's first column
+    static constexpr int tileFloats = 304;          // tileStride * (tileSize + 1), rounded up to whole cache lines
+    static constexpr int minimumSizeForTiles = 2048;
+
+    static_assert (tileFloats >= tileStride * (tileSize + 1) && tileFloats % (int) (alignmentBytes / sizeof (float)) == 0,
+                   "A tile must hold its border and keep the next tile aligned");
+
+    const float* data = nullptr;
+    int width = 0, height = 0;
+    int lineStride = 0; // in floats; rowMajor only
+    Layout layout = Layout::rowMajor;
+    int tilesPerRow = 0; // tiled only
+
+private:
+    float* allocate (int newWidth, int newHeight);
+    float* allocateTiled (int newWidth, int newHeight);
+
+    juce::HeapBlock<float> storage;
+
+    JUCE_DECLARE_NON_COPYABLE (BrightnessPlane)
+};
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    BrightnessPyramid.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "BrightnessPyramid.h"
+
+BrightnessPyramid::BrightnessPyramid (const juce::Image& image)
+{
+    addLevels (new BrightnessPlane (image));
+}
+
+BrightnessPyramid::BrightnessPyramid (const juce::Image& image, const HighPrecisionImage* preciseImage,
+                                      const ProgressCallback& progressCallback)
+{
+    addLevels (preciseImage != nullptr ? new BrightnessPlane (*preciseImage)
+                                       : new BrightnessPlane (image),
+               {}, progressCallback);
+}
+
+BrightnessPyramid::BrightnessPyramid (const juce::Image& image, const HighPrecisionImage* preciseImage, BrightnessPlane::Layout layout)
+{
+    addLevels (preciseImage != nullptr ? new BrightnessPlane (*preciseImage)
+                                       : new BrightnessPlane (image),
+               layout);
+}
+
+BrightnessPyramid::BrightnessPyramid (std::unique_ptr<TerrainFile> terrainFile)
+    : mappedFile (std::move (terrainFile)),
+      uniqueId (createUniqueId())
+{
+    for (int i = 0; i < mappedFile->getNumLevels(); ++i)
+        levels.add (new BrightnessPlane (mappedFile->createLevelView (i)));
+}
+
+juce::uint32 BrightnessPyramid::createUniqueId()
+{
+    static std::atomic<juce::uint32> lastId { 0 };
+    return ++lastId;
+}
+
+void BrightnessPyramid::addLevels (BrightnessPlane* base, std::optional<BrightnessPlane::Layout> layout,
+                                   const ProgressCallback& progressCallback)
+{
+    uniqueId = createUniqueId();
+
+    std::unique_ptr<BrightnessPlane> current (base);
+
+    if (! current->isValid())
+    {
+        levels.add (current.release());
+        return;
+    }
+
+    // The levels add up to about 4/3 of the base, which the progress is measured against.
+    const double totalPixels = (double) current->width * (double) current->height * 4.0 / 3.0;
+    double pixelsDone = 0.0;
+
+    // Halving reads rows, so each level is built rowMajor and only converted
+    // once the next one has been made from it.
+    while (current != nullptr)
+    {
+        std::unique_ptr<BrightnessPlane> next;
+
+        if (current->width > 2 || current->height > 2)
+        {
+            auto half = BrightnessPlane::createHalfSize (*current);
+
+            if (half.isValid())
+                next = std::make_unique<BrightnessPlane> (std::move (half));
+        }
+
+        const auto levelLayout = layout.value_or (BrightnessPlane::getPreferredLayout (current->width, current->height));
+
+        if (levelLayout == BrightnessPlane::Layout::tiled)
+            levels.add (new BrightnessPlane (BrightnessPlane::createTiled (*current)));
+        else
+            levels.add (current.release());
+
+        current = std::move (next);
+
+        if (progressCallback != nullptr)
+        {
+            const auto& added = *levels.getLast();
+            pixelsDone += (double) added.width * (double) added.height;
+
+            if (! progressCallback ((float) juce::jmin (1.0, pixelsDone / totalPixels)))
+            {
+                levels.clear();
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    BrightnessPyramid.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BrightnessPlane.h"
+#include "TerrainFile.h"
+
+/**
+    A mip pyramid of BrightnessPlanes: level 0 is the full image, and each level
+    after it is the previous one box-filtered to half size, down to 2x2. Unless
+    told otherwise, each level takes the layout its size prefers, so large ones
+    are tiled.
+
+    Readers that sweep the image faster than one pixel per sample read from a
+    coarser level instead, which band-limits what they hear. Readers always
+    address a level in normalised [0, 1] coordinates scaled by its own size.
+*/
+class BrightnessPyramid
+{
+public:
+    /** Told how far a build has got, from 0 to 1, after each level. Returning
+        false abandons the build and leaves the pyramid invalid.
+    */
+    using ProgressCallback = std::function<bool (float progress)>;
+
+    BrightnessPyramid() = default;
+    explicit BrightnessPyramid (const juce::Image& image);
+
+    /** Builds the base level from the precise image instead, when there is one. */
+    BrightnessPyramid (const juce::Image& image, const HighPrecisionImage* preciseImage,
+                       const ProgressCallback& progressCallback = {});
+
+    /** Uses one layout for every level, instead of the one each level's size prefers. */
+    BrightnessPyramid (const juce::Image& image, const HighPrecisionImage* preciseImage, BrightnessPlane::Layout layout);
+
+    /** Reads the levels straight from a mapped .iiterrain file, which it keeps open. */
+    explicit BrightnessPyramid (std::unique_ptr<TerrainFile> terrainFile);
+
+    /** True if the levels live in a mapped file rather than in memory of their own. */
+    bool isMemoryMapped() const noexcept { return mappedFile != nullptr; }
+
+    bool isValid() const noexcept { return ! levels.isEmpty() && levels.getUnchecked (0)->isValid(); }
+
+    int getNumLevels() const noexcept { return levels.size(); }
+    const BrightnessPlane& getLevel (int index) const noexcept { return *levels.getUnchecked (index); }
+    const BrightnessPlane& getBase() const noexcept { return getLevel (0); }
+
+    /** The size of all the levels, whether in memory or mapped. */
+    size_t getSizeInBytes() const noexcept
+    {
+        size_t total = 0;
+
+        for (const auto* level : levels)
+            total += level->getSizeInBytes();
+
+        return total;
+    }
+
+    /** Unique across every pyramid built in this process, so caches derived from
+        a pyramid can tell it apart from one later allocated at the same address.
+    */
+    juce::uint32 getUniqueId() const noexcept { return uniqueId; }
+
+    /** Samples the pyramid at a level of detail, blending the two nearest levels.
+        x and y are normalised and must lie within [0, 1]; lod 0 is the full image
+        and each unit above it halves the resolution.
+    */
+    float getTrilinear (float x, float y, float lod) const noexcept
+    {
+        const float maxLevel = (float) (levels.size() - 1);
+        const float clampedLod = juce::jlimit (0.0f, maxLevel, lod);
+        const int level = (int) clampedLod;
+        const float blend = clampedLod - (float) level;
+
+        const float fine = sampleLevel (level, x, y);
+
+        if (blend <= 0.0f)
+            return fine;
+
+        return fine + blend * (sampleLevel (level + 1, x, y) - fine);
+    }
+
+private:
+    void addLevels (BrightnessPlane* base, std::optional<BrightnessPlane::Layout> layout = {},
+                    const ProgressCallback& progressCallback = {});
+    static juce::uint32 createUniqueId();
+
+    float sampleLevel (int index, float x, float y) const noexcept
+    {
+        const auto& plane = getLevel (index);
+        return plane.getInterpolated (x * (float) (plane.width - 1), y * (float) (plane.height - 1));
+    }
+
+    std::unique_ptr<TerrainFile> mappedFile; // Before the levels, which may point into it
+    juce::OwnedArray<BrightnessPlane> levels;
+    juce::uint32 uniqueId = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (BrightnessPyramid)
+};
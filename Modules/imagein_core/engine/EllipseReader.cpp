@@ -0,0 +1,688 @@
+/*
+  ==============================================================================
+
+    EllipseReader.cpp
+    Created: 21 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "EllipseReader.h"
+#include "LFO.h"
+#include "FastMath.h"
+
+namespace
+{
+    float applyMod (float base, float modAmount, float modSignal, bool isBipolar)
+    {
+        if (isBipolar)
+        {
+            float bipolarSignal = modSignal * 2.0f - 1.0f;
+            return base * (1.0f + modAmount * bipolarSignal);
+        }
+        else
+        {
+            float multiplier;
+            if (modAmount >= 0.0f)
+                multiplier = 1.0f + modAmount * (modSignal - 1.0f);
+            else
+                multiplier = 1.0f + modAmount * modSignal;
+            return base * multiplier;
+        }
+    }
+
+   #if JUCE_USE_SIMD
+    using FloatVec = juce::dsp::SIMDRegister<float>;
+    constexpr int vecSize = (int) FloatVec::SIMDNumElements;
+   #endif
+}
+
+EllipseReader::EllipseReader() {}
+EllipseReader::~EllipseReader() {}
+
+void EllipseReader::prepareToPlay (double sr)
+{
+    ReaderBase::prepareToPlay(sr);
+    sampleRate = sr;
+    const double rampTimeSeconds = 0.05;
+    cxs.reset (sampleRate, rampTimeSeconds); cxs.setCurrentAndTargetValue (cx.load());
+    cys.reset (sampleRate, rampTimeSeconds); cys.setCurrentAndTargetValue (cy.load());
+    r1s.reset (sampleRate, rampTimeSeconds); r1s.setCurrentAndTargetValue (r1.load());
+    r2s.reset (sampleRate, rampTimeSeconds); r2s.setCurrentAndTargetValue (r2.load());
+    angles.reset (sampleRate, rampTimeSeconds); angles.setCurrentAndTargetValue (angle.load());
+    volumeSmoother.reset (sampleRate, rampTimeSeconds);
+    volumeSmoother.setCurrentAndTargetValue (volume);
+    panSmoother.setCurrentAndTargetValue(pan.load());
+    usingWavetable = false;
+}
+
+void EllipseReader::setSampleRate (double newSampleRate)
+{
+    ReaderBase::setSampleRate (newSampleRate);
+
+    // The loop wavetable doesn't depend on the rate: it is read at whatever increment the note needs.
+    const double rampTimeSeconds = 0.05;
+    for (auto* smoother : { &cxs, &cys, &r1s, &r2s, &angles, &volumeSmoother })
+        rescaleSmoother (*smoother, sampleRate, rampTimeSeconds);
+}
+
+void EllipseReader::resetPhase()
+{
+    ReaderBase::resetPhase();
+
+    // The rotator now holds the note's starting phase; pick it up from there.
+    usingWavetable = false;
+    hasControlPoint = false;
+}
+
+void EllipseReader::setCentre (float newCx, float newCy)
+{
+    cx = juce::jlimit (0.0f, 1.0f, newCx);
+    cy = juce::jlimit (0.0f, 1.0f, newCy);
+    cxs.setTargetValue (cx.load());
+    cys.setTargetValue (cy.load());
+}
+
+void EllipseReader::setRadii (float newR1, float newR2)
+{
+    r1 = juce::jlimit (0.0f, 0.5f, newR1);
+    r2 = juce::jlimit (0.0f, 0.5f, newR2);
+    r1s.setTargetValue (r1.load());
+    r2s.setTargetValue (r2.load());
+}
+
+void EllipseReader::setAngle (float newAngle)
+{
+    angle = newAngle;
+    angles.setTargetValue (angle.load());
+}
+
+LoopWavetable::Geometry EllipseReader::getSettledGeometry (const EllipseReaderParameters& params)
+{
+    // The values the smoothers settle on: the targets, clamped as setCentre and setRadii do.
+    LoopWavetable::Geometry geometry;
+    geometry.cx = juce::jlimit (0.0f, 1.0f, params.cx);
+    geometry.cy = juce::jlimit (0.0f, 1.0f, params.cy);
+    geometry.r1 = juce::jlimit (0.0f, 0.5f, params.r1);
+    geometry.r2 = juce::jlimit (0.0f, 0.5f, params.r2);
+    geometry.angle = params.angle;
+    return geometry;
+}
+
+void EllipseReader::updateParameters (const EllipseReaderParameters& params)
+{
+    setCentre (params.cx, params.cy);
+    setRadii (params.r1, params.r2);
+    setAngle (params.angle);
+    setVolume (params.volume);
+    setPan(params.pan);
+    detune = params.detune;
+    updateFilterParameters(params.filter);
+
+    modCxAmount = params.modCxAmount;
+    modCyAmount = params.modCyAmount;
+    modR1Amount = params.modR1Amount;
+    modR2Amount = params.modR2Amount;
+    modAngleAmount = params.modAngleAmount;
+    modVolumeAmount = params.modVolumeAmount;
+
+    modCxSelect = params.modCxSelect;
+    modCySelect = params.modCySelect;
+    modR1Select = params.modR1Select;
+    modR2Select = params.modR2Select;
+    modAngleSelect = params.modAngleSelect;
+    modVolumeSelect = params.modVolumeSelect;
+    modPanAmount = params.modPanAmount;
+    modPanSelect = params.modPanSelect;
+    modFreqAmount = params.modFreqAmount;
+    modFreqSelect = params.modFreqSelect;
+}
+
+// The kernel below runs in four passes over chunks of up to kernelBlockSize samples:
+//   1. fillGeometry       - smoothing and modulation of the ellipse, volume, pan and pitch,
+//                           per sample or at control rate (see setModulationInterval),
+//   2. advancePhases      - cos/sin of the three octave phases, from the PhaseRotator,
+//      computeTrajectory  - normalised x/y for every tap, vectorised,
+//   3. samplePyramid      - trilinear lookups into the brightness pyramid and the tap mix,
+//   4. renderOutput       - filter, volume and pan.
+// When the geometry has settled and nothing modulates it, passes 2 and 3 are replaced
+// by readWavetable, which plays the loop back from a band-limited LoopWavetable.
+// The vectorised arithmetic may differ from scalar code by a few ulps. The phases
+// come from a recursive rotator rather than std::cos/std::sin of float phase
+// accumulators; it drifts from the exact phase less than those accumulators did.
+void EllipseReader::processBlock (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                                 const juce::AudioBuffer<float>& modulatorBuffer)
+{
+    if (! pyramid.isValid())
+    {
+        buffer.clear(startSample, numSamples);
+        return;
+    }
+
+    for (int offset = 0; offset < numSamples; offset += kernelBlockSize)
+    {
+        const int chunkStart = startSample + offset;
+        const int chunkSize = juce::jmin (kernelBlockSize, numSamples - offset);
+
+        fillGeometry (modulatorBuffer, chunkStart, chunkSize, offset + chunkSize == numSamples);
+
+        const LoopWavetable* wavetable = nullptr;
+
+        if (kernel.geometryIsStatic && sharedWavetable != nullptr)
+        {
+            auto geometry = kernel.staticGeometry;
+            geometry.pyramidId = pyramid.getUniqueId();
+            wavetable = sharedWavetable->find (geometry);
+        }
+
+        // Until the synth has built the table, the loop is scanned like moving geometry.
+        if (wavetable != nullptr)
+        {
+            enterWavetableMode();
+            readWavetable (*wavetable, chunkSize);
+        }
+        else
+        {
+            leaveWavetableMode();
+            advancePhases (chunkSize);
+            computeTrajectory (chunkSize);
+            samplePyramid (pyramid, chunkSize);
+        }
+
+        renderOutput (buffer, modulatorBuffer, chunkStart, chunkSize);
+    }
+}
+
+void EllipseReader::setModulationInterval (int numSamples)
+{
+    modulationInterval = juce::jlimit (1, kernelBlockSize, numSamples);
+}
+
+void EllipseReader::fillGeometry (const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples, bool isEndOfBlock)
+{
+    auto& k = kernel;
+
+    const float* modCx = modulatorBuffer.getReadPointer (modCxSelect.load(), startSample);
+    const float* modCy = modulatorBuffer.getReadPointer (modCySelect.load(), startSample);
+    const float* modR1 = modulatorBuffer.getReadPointer (modR1Select.load(), startSample);
+    const float* modR2 = modulatorBuffer.getReadPointer (modR2Select.load(), startSample);
+    const float* modAngle = modulatorBuffer.getReadPointer (modAngleSelect.load(), startSample);
+    const float* modVolume = modulatorBuffer.getReadPointer (modVolumeSelect.load(), startSample);
+    const float* modPan = modulatorBuffer.getReadPointer (modPanSelect.load(), startSample);
+    const float* modFreq = modulatorBuffer.getReadPointer (modFreqSelect.load(), startSample);
+
+    const float cxAmount = modCxAmount.load();
+    const float cyAmount = modCyAmount.load();
+    const float r1Amount = modR1Amount.load();
+    const float r2Amount = modR2Amount.load();
+    const float angleAmount = modAngleAmount.load();
+    const float volumeAmount = modVolumeAmount.load();
+    const float panAmount = modPanAmount.load();
+    const float freqAmount = modFreqAmount.load();
+    const float detuneSemitones = detune.load();
+    if (detuneSemitones != cachedDetune)
+    {
+        cachedDetune = detuneSemitones;
+        detuneRatio = FastMath::semitonesToRatio (detuneSemitones);
+    }
+    const int interval = modulationInterval.load();
+
+    for (auto& active : k.tapActive)
+        active = false;
+
+    // Unmodulated, settled smoothers keep the same value for the whole chunk.
+    k.geometryIsStatic = cxAmount == 0.0f && cyAmount == 0.0f && r1Amount == 0.0f && r2Amount == 0.0f && angleAmount == 0.0f
+                      && ! cxs.isSmoothing() && ! cys.isSmoothing() && ! r1s.isSmoothing() && ! r2s.isSmoothing() && ! angles.isSmoothing();
+
+    if (k.geometryIsStatic)
+    {
+        k.staticGeometry.cx = juce::jlimit (0.0f, 1.0f, cxs.getCurrentValue());
+        k.staticGeometry.cy = juce::jlimit (0.0f, 1.0f, cys.getCurrentValue());
+        k.staticGeometry.r1 = juce::jlimit (0.0f, 0.5f, r1s.getCurrentValue());
+        k.staticGeometry.r2 = juce::jlimit (0.0f, 0.5f, r2s.getCurrentValue());
+        k.staticGeometry.angle = angles.getCurrentValue();
+    }
+
+    // Smoothed and modulated values at sample i, with the smoothers moved on by
+    // numSteps samples (1 at audio rate, the segment length at control rate).
+    auto evaluate = [&] (int i, int numSteps)
+    {
+        auto advance = [numSteps] (juce::LinearSmoothedValue<float>& smoother)
+        {
+            return numSteps == 1 ? smoother.getNextValue() : smoother.skip (numSteps);
+        };
+
+        // Get smoothed base values
+        float cx_base = advance (cxs);
+        float cy_base = advance (cys);
+        float r1_base = advance (r1s);
+        float r2_base = advance (r2s);
+        float angle_base = advance (angles);
+        float volume_base = advance (volumeSmoother);
+        float pan_base = advance (panSmoother);
+
+        ControlValues v;
+
+        // Apply modulation
+        v.cx = applyMod (cx_base, cxAmount, modCx[i], true);
+        v.cy = applyMod (cy_base, cyAmount, modCy[i], true);
+        v.r1 = applyMod (r1_base, r1Amount, modR1[i], true);
+        v.r2 = applyMod (r2_base, r2Amount, modR2[i], true);
+        v.angle = applyMod (angle_base, angleAmount, modAngle[i], true);
+        v.volume = applyMod (volume_base, volumeAmount, modVolume[i], false);
+
+        // Pan is additive, not multiplicative
+        const float panModSignal = modPan[i] * 2.0f - 1.0f; // to [-1, 1]
+        v.pan = pan_base + panAmount * panModSignal;
+
+        // --- Frequency Modulation ---
+        float modulatedFreq = frequency;
+
+        if (freqAmount != 0.0f)
+        {
+            const float bipolarFreqMod = modFreq[i] * 2.0f - 1.0f;
+            const float numOctaves = 1.0f;
+            modulatedFreq *= FastMath::exp2 (freqAmount * bipolarFreqMod * numOctaves);
+        }
+
+        const float detunedFreq = modulatedFreq * detuneRatio;
+        v.phaseIncrement = detunedFreq / (float) sampleRate;
+        return v;
+    };
+
+    if (interval <= 1)
+    {
+        // The angle rarely moves from one sample to the next, so its cos/sin are cached.
+        float cachedAngle = 0.0f, cosAngle = 1.0f, sinAngle = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto v = evaluate (i, 1);
+
+            if (v.angle != cachedAngle)
+            {
+                cachedAngle = v.angle;
+                cosAngle = std::cos (v.angle);
+                sinAngle = std::sin (v.angle);
+            }
+
+            v.cosAngle = cosAngle;
+            v.sinAngle = sinAngle;
+            writeGeometry (i, v, isEndOfBlock && i == numSamples - 1);
+        }
+
+        hasControlPoint = false;
+        return;
+    }
+
+    // Control rate: modulation is only evaluated at the end of each segment, and the
+    // samples in between ramp linearly from the previous control point. The cos/sin
+    // of the angle are ramped too, which is accurate to second order in the step.
+    for (int segmentStart = 0; segmentStart < numSamples; segmentStart += interval)
+    {
+        const int segmentLength = juce::jmin (interval, numSamples - segmentStart);
+
+        auto target = evaluate (segmentStart + segmentLength - 1, segmentLength);
+        target.cosAngle = std::cos (target.angle);
+        target.sinAngle = std::sin (target.angle);
+
+        if (! hasControlPoint)
+        {
+            lastControlPoint = target;
+            hasControlPoint = true;
+        }
+
+        const auto& from = lastControlPoint;
+        const float step = 1.0f / (float) segmentLength;
+
+        for (int j = 0; j < segmentLength; ++j)
+        {
+            const float t = (float) (j + 1) * step;
+            auto ramp = [t] (float a, float b) { return a + t * (b - a); };
+
+            ControlValues v;
+            v.cx = ramp (from.cx, target.cx);
+            v.cy = ramp (from.cy, target.cy);
+            v.r1 = ramp (from.r1, target.r1);
+            v.r2 = ramp (from.r2, target.r2);
+            v.angle = ramp (from.angle, target.angle);
+            v.cosAngle = ramp (from.cosAngle, target.cosAngle);
+            v.sinAngle = ramp (from.sinAngle, target.sinAngle);
+            v.volume = ramp (from.volume, target.volume);
+            v.pan = ramp (from.pan, target.pan);
+            v.phaseIncrement = ramp (from.phaseIncrement, target.phaseIncrement);
+
+            const int i = segmentStart + j;
+            writeGeometry (i, v, isEndOfBlock && i == numSamples - 1);
+        }
+
+        lastControlPoint = target;
+    }
+}
+
+void EllipseReader::writeGeometry (int i, const ControlValues& v, bool isLastSample)
+{
+    auto& k = kernel;
+
+    k.phaseIncrement[i] = v.phaseIncrement;
+
+    // Optimization: if volume is zero, we can skip the expensive sample reading part.
+    // The geometry is neutralised so the vector passes stay finite, and the zero
+    // tap gains make samplePyramid skip it.
+    if (v.volume < 0.0001f)
+    {
+        k.cx[i] = k.cy[i] = k.r1[i] = k.r2[i] = 0.0f;
+        k.cosAngle[i] = 1.0f;
+        k.sinAngle[i] = 0.0f;
+        k.volume[i] = 0.0f;
+        k.pan[i] = 0.0f;
+
+        for (auto& gain : k.tapGain)
+            gain[i] = 0.0f;
+
+        if (isLastSample)
+            lastDrawingInfo.isActive = false;
+
+        return;
+    }
+
+    // Clamp modulated values
+    const float cx_sv = juce::jlimit (0.0f, 1.0f, v.cx);
+    const float cy_sv = juce::jlimit (0.0f, 1.0f, v.cy);
+    const float r1_sv = juce::jlimit (0.0f, 0.5f, v.r1);
+    const float r2_sv = juce::jlimit (0.0f, 0.5f, v.r2);
+
+    if (isLastSample)
+    {
+        lastDrawingInfo.isActive = true;
+        lastDrawingInfo.type = Type::Ellipse;
+        lastDrawingInfo.volume = v.volume;
+        lastDrawingInfo.cx = cx_sv;
+        lastDrawingInfo.cy = cy_sv;
+        lastDrawingInfo.r1 = r1_sv;
+        lastDrawingInfo.r2 = r2_sv;
+        lastDrawingInfo.angle = v.angle;
+    }
+
+    k.cx[i] = cx_sv;
+    k.cy[i] = cy_sv;
+    k.r1[i] = r1_sv;
+    k.r2[i] = r2_sv;
+    k.cosAngle[i] = v.cosAngle;
+    k.sinAngle[i] = v.sinAngle;
+    k.volume[i] = v.volume;
+    k.pan[i] = v.pan;
+
+    const float normalizedLength = (r1_sv + r2_sv); // Map average radius to [0, 1] for amplitude calculation
+
+    const float ampHigh = juce::jmax (0.0f, 1.0f - normalizedLength * 2.0f);
+    const float ampBase = 1.0f - std::abs (normalizedLength - 0.5f) * 2.0f;
+    const float ampLow  = juce::jmax (0.0f, (normalizedLength - 0.5f) * 2.0f);
+
+    k.tapGain[0][i] = ampLow;
+    k.tapGain[1][i] = ampBase;
+    k.tapGain[2][i] = ampHigh;
+
+    k.tapActive[0] = k.tapActive[0] || ampLow > 0.0f;
+    k.tapActive[1] = k.tapActive[1] || ampBase > 0.0f;
+    k.tapActive[2] = k.tapActive[2] || ampHigh > 0.0f;
+}
+
+void EllipseReader::advancePhases (int numSamples)
+{
+    auto& k = kernel;
+
+    // The rotator keeps all three taps turning, active or not, so they stay in sync.
+    // Its rotation is only rebuilt when frequency modulation moves the increment.
+    for (int i = 0; i < numSamples; ++i)
+    {
+        phaseRotator.setIncrement (k.phaseIncrement[i]);
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            k.cosPhase[tap][i] = phaseRotator.getCos (tap);
+            k.sinPhase[tap][i] = phaseRotator.getSin (tap);
+        }
+
+        phaseRotator.advance();
+    }
+
+    phaseRotator.renormalise();
+}
+
+void EllipseReader::computeTrajectory (int numSamples)
+{
+    auto& k = kernel;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        if (! k.tapActive[tap])
+            continue;
+
+        const float* cosPhase = k.cosPhase[tap];
+        const float* sinPhase = k.sinPhase[tap];
+        float* pathX = k.pathX[tap];
+        float* pathY = k.pathY[tap];
+
+       #if JUCE_USE_SIMD
+        // The arrays are padded to kernelBlockSize, so the last vector may run past
+        // numSamples; those lanes are simply never read.
+        const auto zero = FloatVec::expand (0.0f);
+        const auto one = FloatVec::expand (1.0f);
+
+        for (int i = 0; i < numSamples; i += vecSize)
+        {
+            const auto cp = FloatVec::fromRawArray (cosPhase + i);
+            const auto sp = FloatVec::fromRawArray (sinPhase + i);
+            const auto ca = FloatVec::fromRawArray (k.cosAngle + i);
+            const auto sa = FloatVec::fromRawArray (k.sinAngle + i);
+            const auto r1v = FloatVec::fromRawArray (k.r1 + i);
+            const auto r2v = FloatVec::fromRawArray (k.r2 + i);
+
+            const auto currentX = FloatVec::fromRawArray (k.cx + i) + (r1v * cp * ca - r2v * sp * sa);
+            const auto currentY = FloatVec::fromRawArray (k.cy + i) + (r1v * cp * sa + r2v * sp * ca);
+
+            FloatVec::min (FloatVec::max (currentX, zero), one).copyToRawArray (pathX + i);
+            FloatVec::min (FloatVec::max (currentY, zero), one).copyToRawArray (pathY + i);
+        }
+       #else
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float currentX = k.cx[i] + (k.r1[i] * cosPhase[i] * k.cosAngle[i] - k.r2[i] * sinPhase[i] * k.sinAngle[i]);
+            const float currentY = k.cy[i] + (k.r1[i] * cosPhase[i] * k.sinAngle[i] + k.r2[i] * sinPhase[i] * k.cosAngle[i]);
+
+            pathX[i] = juce::jlimit (0.0f, 1.0f, currentX);
+            pathY[i] = juce::jlimit (0.0f, 1.0f, currentY);
+        }
+       #endif
+    }
+}
+
+float EllipseReader::getLevelOfDetail (const BrightnessPyramid& pyramid, int tap, int numSamples) const
+{
+    const auto& k = kernel;
+
+    // Fastest point of the path over the chunk, in full-resolution pixels per sample.
+    // The ellipse moves at most 2 pi max(r1, r2) per cycle; the tap runs at half,
+    // once or twice the base increment.
+    float maxSpeed = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+        maxSpeed = juce::jmax (maxSpeed, k.phaseIncrement[i] * juce::jmax (k.r1[i], k.r2[i]));
+
+    const auto& base = pyramid.getBase();
+    const float tapRatio = (float) (1 << tap) * 0.5f;
+    const float pixelsPerSample = maxSpeed * tapRatio * juce::MathConstants<float>::twoPi
+                                * (float) juce::jmax (base.width - 1, base.height - 1);
+
+    // Up to one pixel per sample the full image is safe to read; every doubling
+    // beyond that moves one level down the pyramid.
+    return pixelsPerSample > 1.0f ? std::log2 (pixelsPerSample) : 0.0f;
+}
+
+void EllipseReader::samplePyramid (const BrightnessPyramid& pyramid, int numSamples)
+{
+    auto& k = kernel;
+
+    for (int i = 0; i < numSamples; ++i)
+        k.output[i] = 0.0f;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        if (! k.tapActive[tap])
+            continue;
+
+        const float* gain = k.tapGain[tap];
+        const float* pathX = k.pathX[tap];
+        const float* pathY = k.pathY[tap];
+        float* value = k.tapValue[tap];
+
+        // One level of detail per chunk and tap keeps log2 out of the per-sample loop.
+        const float lod = getLevelOfDetail (pyramid, tap, numSamples);
+
+        // There is no gather instruction to lean on here, so the lookups stay scalar.
+        if (lod <= 0.0f)
+        {
+            const auto& plane = pyramid.getBase();
+            const float imageWidth = (float) (plane.width - 1);
+            const float imageHeight = (float) (plane.height - 1);
+
+            for (int i = 0; i < numSamples; ++i)
+                value[i] = gain[i] > 0.0f ? plane.getInterpolated (pathX[i] * imageWidth, pathY[i] * imageHeight) : 0.0f;
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                value[i] = gain[i] > 0.0f ? pyramid.getTrilinear (pathX[i], pathY[i], lod) : 0.0f;
+        }
+
+        // Mix in tap order (low, base, high), as the scalar loop used to.
+       #if JUCE_USE_SIMD
+        for (int i = 0; i < numSamples; i += vecSize)
+        {
+            const auto mixed = FloatVec::fromRawArray (k.output + i)
+                             + FloatVec::fromRawArray (gain + i) * FloatVec::fromRawArray (value + i);
+            mixed.copyToRawArray (k.output + i);
+        }
+       #else
+        for (int i = 0; i < numSamples; ++i)
+            k.output[i] += gain[i] * value[i];
+       #endif
+    }
+}
+
+void EllipseReader::enterWavetableMode()
+{
+    if (usingWavetable)
+        return;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+        wavetablePhases[tap] = phaseRotator.getPhase (tap);
+
+    usingWavetable = true;
+}
+
+void EllipseReader::leaveWavetableMode()
+{
+    if (! usingWavetable)
+        return;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+        phaseRotator.setPhase (tap, wavetablePhases[tap]);
+
+    usingWavetable = false;
+}
+
+void EllipseReader::readWavetable (const LoopWavetable& wavetable, int numSamples)
+{
+    auto& k = kernel;
+
+    for (int i = 0; i < numSamples; ++i)
+        k.output[i] = 0.0f;
+
+    float maxIncrement = 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+        maxIncrement = juce::jmax (maxIncrement, k.phaseIncrement[i]);
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const float ratio = (float) (1 << tap) * 0.5f;
+        float currentPhase = wavetablePhases[tap];
+
+        // Phases keep running on silent taps so the octaves stay in sync.
+        if (k.tapActive[tap])
+        {
+            const float* table = wavetable.getTableFor (maxIncrement * ratio);
+            const float* gain = k.tapGain[tap];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float position = currentPhase * (float) LoopWavetable::tableSize;
+                const int index = juce::jmin ((int) position, LoopWavetable::tableSize - 1);
+                const float frac = position - (float) index;
+                const float value = table[index] + frac * (table[index + 1] - table[index]);
+
+                k.output[i] += gain[i] * value;
+
+                // A modulated increment can move the phase by more than a cycle.
+                currentPhase += k.phaseIncrement[i] * ratio;
+                currentPhase -= std::floor (currentPhase);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                currentPhase += k.phaseIncrement[i] * ratio;
+                currentPhase -= std::floor (currentPhase);
+            }
+        }
+
+        wavetablePhases[tap] = currentPhase;
+    }
+}
+
+void EllipseReader::renderOutput (juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples)
+{
+    auto& k = kernel;
+
+    const float* modFilterFreq = modulatorBuffer.getReadPointer (modFilterFreqSelect.load(), startSample);
+    const float* modFilterQuality = modulatorBuffer.getReadPointer (modFilterQualitySelect.load(), startSample);
+
+    const int numChannels = buffer.getNumChannels();
+    float* left = numChannels > 0 ? buffer.getWritePointer (0, startSample) : nullptr;
+    float* right = numChannels > 1 ? buffer.getWritePointer (1, startSample) : nullptr;
+
+    const float centreAngle = juce::MathConstants<float>::halfPi * 0.5f;
+    float cachedPan = 0.0f, leftGain = std::cos (centreAngle), rightGain = std::sin (centreAngle);
+
+    applyFilter (k.output, modFilterFreq, modFilterQuality, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Buffer is additive, so silent samples add nothing
+        if (k.volume[i] < 0.0001f)
+            continue;
+
+        // Apply Volume and Pan
+        float finalSampleValue = k.output[i] * k.volume[i];
+
+        if (k.pan[i] != cachedPan)
+        {
+            cachedPan = k.pan[i];
+            const float panAngle = (juce::jlimit(-1.0f, 1.0f, cachedPan) * 0.5f + 0.5f) * juce::MathConstants<float>::halfPi;
+            leftGain = std::cos(panAngle);
+            rightGain = std::sin(panAngle);
+        }
+
+        if (left != nullptr)
+            left[i] += finalSampleValue * leftGain;
+        if (right != nullptr)
+            right[i] += finalSampleValue * rightGain;
+    }
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    EllipseReader.h
+    Created: 21 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ReaderBase.h"
+#include "ParameterStructs.h"
+#include "LoopWavetable.h"
+
+class EllipseReader : public ReaderBase
+{
+public:
+    EllipseReader();
+    ~EllipseReader() override;
+
+    void processBlock (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const juce::AudioBuffer<float>& modulatorBuffer) override;
+
+    void setCentre (float newCx, float newCy);
+    void setRadii (float newR1, float newR2);
+    void setAngle (float newAngle);
+
+    void updateParameters (const EllipseReaderParameters& params);
+
+    /** The table the voices of this reader's synth share for static geometry. Without
+        one, the reader always scans the image.
+    */
+    void setLoopWavetable (SharedLoopWavetable* newWavetable) noexcept { sharedWavetable = newWavetable; }
+
+    /** The loop an unmodulated reader settles on with these parameters. */
+    static LoopWavetable::Geometry getSettledGeometry (const EllipseReaderParameters& params);
+
+    /** Evaluates geometry modulation every numSamples samples and ramps linearly in
+        between; 1 evaluates it at audio rate.
+    */
+    void setModulationInterval (int numSamples);
+    Type getType() const override { return Type::Ellipse; }
+    void prepareToPlay (double sampleRate) override;
+    void setSampleRate (double newSampleRate) override;
+    void resetPhase() override;
+
+private:
+    // processBlock works through the block in chunks of this many samples,
+    // so the scratch arrays below never need to grow on the audio thread.
+    static constexpr int kernelBlockSize = 64;
+    static constexpr int numTaps = 3; // octave below, base, octave above
+
+    /** Per-chunk arrays shared by the passes of processBlock. */
+    struct KernelBuffers
+    {
+        alignas (32) float cx[kernelBlockSize];
+        alignas (32) float cy[kernelBlockSize];
+        alignas (32) float r1[kernelBlockSize];
+        alignas (32) float r2[kernelBlockSize];
+        alignas (32) float cosAngle[kernelBlockSize];
+        alignas (32) float sinAngle[kernelBlockSize];
+        alignas (32) float volume[kernelBlockSize];
+        alignas (32) float pan[kernelBlockSize];
+        alignas (32) float phaseIncrement[kernelBlockSize];
+        alignas (32) float output[kernelBlockSize];
+
+        alignas (32) float tapGain[numTaps][kernelBlockSize];
+        alignas (32) float cosPhase[numTaps][kernelBlockSize];
+        alignas (32) float sinPhase[numTaps][kernelBlockSize];
+        alignas (32) float pathX[numTaps][kernelBlockSize]; // normalised, clamped to [0, 1]
+        alignas (32) float pathY[numTaps][kernelBlockSize];
+        alignas (32) float tapValue[numTaps][kernelBlockSize];
+
+        bool tapActive[numTaps] = {};
+
+        // Set by fillGeometry when no geometry parameter moves during the chunk.
+        bool geometryIsStatic = false;
+        LoopWavetable::Geometry staticGeometry;
+    };
+
+    /** Modulated per-sample values, before clamping. */
+    struct ControlValues
+    {
+        float cx = 0.0f, cy = 0.0f, r1 = 0.0f, r2 = 0.0f;
+        float angle = 0.0f, cosAngle = 1.0f, sinAngle = 0.0f;
+        float volume = 0.0f, pan = 0.0f, phaseIncrement = 0.0f;
+    };
+
+    void fillGeometry (const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples, bool isEndOfBlock);
+    void writeGeometry (int index, const ControlValues& values, bool isLastSample);
+    void advancePhases (int numSamples);
+    void computeTrajectory (int numSamples);
+    float getLevelOfDetail (const BrightnessPyramid& pyramid, int tap, int numSamples) const;
+    void samplePyramid (const BrightnessPyramid& pyramid, int numSamples);
+    void readWavetable (const LoopWavetable& wavetable, int numSamples);
+    void enterWavetableMode();
+    void leaveWavetableMode();
+    void renderOutput (juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples);
+
+    KernelBuffers kernel {};
+
+    std::atomic<int> modulationInterval { 1 };
+
+    // Only recomputed when the detune parameter moves.
+    float cachedDetune = 0.0f, detuneRatio = 1.0f;
+    ControlValues lastControlPoint;
+    bool hasControlPoint = false;
+
+    // Static geometry plays back from the synth's table instead of scanning the image.
+    SharedLoopWavetable* sharedWavetable = nullptr;
+    bool usingWavetable = false;
+    float wavetablePhases[numTaps] = {};
+
+    std::atomic<float> cx { 0.5f }, cy { 0.5f };
+    std::atomic<float> r1 { 0.4f }, r2 { 0.2f }, angle { 0.0f };
+
+    juce::LinearSmoothedValue<float> cxs, cys, r1s, r2s, angles;
+
+public:
+    std::atomic<float> modCxAmount { 0.0f }, modCyAmount { 0.0f }, modR1Amount { 0.0f }, modR2Amount { 0.0f }, modAngleAmount { 0.0f }, modVolumeAmount { 0.0f };
+
+    std::atomic<int> modCxSelect { 0 }, modCySelect { 0 }, modR1Select { 0 }, modR2Select { 0 }, modAngleSelect { 0 }, modVolumeSelect { 0 };
+
+    std::atomic<float> modFreqAmount { 0.0f };
+    std::atomic<int> modFreqSelect { 0 };
+    
+    std::atomic<float> detune { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EllipseReader)
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    EngineSettings.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "EngineSettings.h"
+
+EngineSettings::EngineSettings()
+{
+    // The ellipses' defaults differ from those of EllipseReaderParameters
+    for (int i = 0; i < (int) globalParams.ellipses.size(); ++i)
+    {
+        auto& e = globalParams.ellipses[(size_t) i];
+        const int index = i + 1;
+
+        e.on = index == 1;
+        e.r1 = 0.4f - (index - 1) * 0.1f;
+        e.r2 = 0.2f - (index - 1) * 0.05f;
+        e.volume = (index == 1) ? 1.0f : 0.0f;
+        e.modVolumeAmount = 1.0f;
+        e.modVolumeSelect = ModulatorSources::ADSR1;
+    }
+
+    globalParams.modulationInterval = modulationIntervals[0];
+    globalParams.polyphony = 4;
+}
+
+bool EngineSettings::loadFromXml (const juce::XmlElement& xml)
+{
+    if (! xml.hasTagName ("Parameters"))
+        return false;
+
+    juce::NamedValueSet values;
+
+    for (auto* param : xml.getChildWithTagNameIterator ("PARAM"))
+        if (param->getStringAttribute ("id").isNotEmpty() && param->hasAttribute ("value"))
+            values.set (param->getStringAttribute ("id"), param->getDoubleAttribute ("value"));
+
+    // Same conversions as MapSynthAudioProcessor::updateParameters()
+    auto read = [&values] (const juce::String& parameterID, auto& target)
+    {
+        if (auto* value = values.getVarPointer (parameterID))
+        {
+            const auto v = (float) (double) *value;
+
+            if constexpr (std::is_same_v<std::decay_t<decltype (target)>, bool>)
+                target = v > 0.5f;
+            else if constexpr (std::is_same_v<std::decay_t<decltype (target)>, int>)
+                target = (int) v;
+            else
+                target = v;
+        }
+    };
+
+    for (int i = 0; i < (int) globalParams.ellipses.size(); ++i)
+    {
+        auto& e = globalParams.ellipses[(size_t) i];
+        const juce::String prefix = "Ellipse" + juce::String (i + 1) + "_";
+        const juce::String modPrefix = "Mod_" + prefix;
+
+        read (prefix + "On", e.on);
+        read (prefix + "ShowMaster", e.showMaster);
+        read (prefix + "MidiChannel", e.midiChannel);
+        read (prefix + "CX", e.cx);
+        read (prefix + "CY", e.cy);
+        read (prefix + "R1", e.r1);
+        read (prefix + "R2", e.r2);
+        read (prefix + "Angle", e.angle);
+        read (prefix + "Volume", e.volume);
+        read (prefix + "Detune", e.detune);
+        read (prefix + "Pan", e.pan);
+        read (prefix + "Oversampling", e.oversampling);
+
+        read (modPrefix + "CX_Amount", e.modCxAmount);
+        read (modPrefix + "CX_Select", e.modCxSelect);
+        read (modPrefix + "CY_Amount", e.modCyAmount);
+        read (modPrefix + "CY_Select", e.modCySelect);
+        read (modPrefix + "R1_Amount", e.modR1Amount);
+        read (modPrefix + "R1_Select", e.modR1Select);
+        read (modPrefix + "R2_Amount", e.modR2Amount);
+        read (modPrefix + "R2_Select", e.modR2Select);
+        read (modPrefix + "Angle_Amount", e.modAngleAmount);
+        read (modPrefix + "Angle_Select", e.modAngleSelect);
+        read (modPrefix + "Volume_Amount", e.modVolumeAmount);
+        read (modPrefix + "Volume_Select", e.modVolumeSelect);
+        read (modPrefix + "Pan_Amount", e.modPanAmount);
+        read (modPrefix + "Pan_Select", e.modPanSelect);
+        read (modPrefix + "Freq_Amount", e.modFreqAmount);
+        read (modPrefix + "Freq_Select", e.modFreqSelect);
+
+        read (prefix + "FilterType", e.filter.type);
+        read (prefix + "FilterFreq", e.filter.frequency);
+        read (prefix + "FilterQuality", e.filter.quality);
+        read (modPrefix + "FilterFreq_Amount", e.filter.modFreqAmount);
+        read (modPrefix + "FilterFreq_Select", e.filter.modFreqSelect);
+        read (modPrefix + "FilterQuality_Amount", e.filter.modQualityAmount);
+        read (modPrefix + "FilterQuality_Select", e.filter.modQualitySelect);
+    }
+
+    // The first ADSR has no suffix, the others are numbered from 2.
+    std::array<ADSRParameters*, 3> adsrs { &globalParams.adsr, &globalParams.adsr2, &globalParams.adsr3 };
+
+    for (int i = 0; i < (int) adsrs.size(); ++i)
+    {
+        auto& a = *adsrs[(size_t) i];
+        const juce::String suffix = i == 0 ? juce::String() : juce::String (i + 1);
+
+        read ("Attack" + suffix, a.attack);
+        read ("Decay" + suffix, a.decay);
+        read ("Sustain" + suffix, a.sustain);
+        read ("Release" + suffix, a.release);
+    }
+
+    for (int i = 0; i < (int) lfos.size(); ++i)
+    {
+        auto& l = lfos[(size_t) i];
+        const juce::String prefix = "LFO" + juce::String (i + 1);
+
+        int waveform = (int) l.waveform;
+        read (prefix + "Wave", waveform);
+        l.waveform = (LFO::Waveform) waveform;
+
+        read (prefix + "Sync", l.sync);
+        read (prefix + "Rate", l.rate);
+        read (prefix + "Freq", l.frequency);
+        read (prefix + "Phase", l.phase);
+    }
+
+    auto modulationRate = (int) (std::find (std::begin (modulationIntervals), std::end (modulationIntervals),
+                                            globalParams.modulationInterval) - std::begin (modulationIntervals));
+    read ("ModulationRate", modulationRate);
+    globalParams.modulationInterval = modulationIntervals[juce::jlimit (0, modulationRateChoices.size() - 1, modulationRate)];
+
+    read ("Polyphony", globalParams.polyphony);
+    read ("MultiThreaded", multiThreaded);
+    read ("Level", levelDecibels);
+    read ("FactoryImage", factoryImage);
+
+    imagePath = xml.getStringAttribute ("imagePath");
+    return true;
+}
+
+void EngineSettings::applyTo (ImageInEngine& engine, double bpm) const
+{
+    engine.globalParams = globalParams;
+
+    for (int i = 0; i < (int) lfos.size(); ++i)
+    {
+        const auto& l = lfos[(size_t) i];
+        const float frequency = l.sync ? (float) (bpm / 60.0 * getTempoSyncRateMultiplier (l.rate)) : l.frequency;
+        engine.setLfo (i, l.waveform, frequency, l.phase);
+    }
+
+    engine.setMultiThreaded (multiThreaded);
+    engine.setOutputLevel (levelDecibels);
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    EngineSettings.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterStructs.h"
+#include "LFO.h"
+#include "ImageInEngine.h"
+
+/**
+    Everything a preset sets on an ImageInEngine, read straight from the preset's
+    XML: the plugin's saved state, a <Parameters> element with one
+    <PARAM id="..." value="..."/> child per parameter.
+
+    The plugin fills its engine from its parameters; this is for the tools, which
+    drive an ImageInEngine without the plugin. Parameters missing from the XML
+    keep their default, so the IDs and defaults here must follow
+    MapSynthAudioProcessor::createParameters().
+*/
+struct EngineSettings
+{
+    struct LfoSettings
+    {
+        LFO::Waveform waveform = LFO::Waveform::Sine;
+        bool sync = false;
+        int rate = 8;           // index into tempoSyncRateChoices, when synced
+        float frequency = 1.0f; // in Hz, when not synced
+        float phase = 0.0f;
+    };
+
+    /** The plugin's default settings. */
+    EngineSettings();
+
+    /** Reads a preset over these settings. Returns false, changing nothing, if xml isn't one. */
+    bool loadFromXml (const juce::XmlElement& xml);
+
+    /** Sets the engine's parameters, LFOs, render mode and level. bpm drives the synced LFOs. */
+    void applyTo (ImageInEngine& engine, double bpm) const;
+
+    GlobalParameters globalParams;
+    std::array<LfoSettings, ImageInEngine::numLfos> lfos;
+    float levelDecibels = 0.0f;
+    bool multiThreaded = false;
+
+    int factoryImage = 1;   // 1-based index into the factory images, 0 for a custom image
+    juce::String imagePath; // the custom image, if the preset was saved with one
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Cheap replacements for the transcendental functions used on the audio thread.
+*/
+namespace FastMath
+{
+    /** 2^x for x within [-126, 126] (values outside are clamped).
+
+        x is split into a nearest integer n and a fraction f within [-0.5, 0.5].
+        2^n is built directly in the exponent bits, and 2^f = e^(f ln 2) comes from
+        its degree-6 Taylor polynomial. The truncation error is below
+        (ln 2 / 2)^7 / 7! = 1.2e-7 relative, so the result is within about
+        3e-7 of std::exp2 (a few ulps) over the whole range.
+    */
+    inline float exp2 (float x) noexcept
+    {
+        x = juce::jlimit (-126.0f, 126.0f, x);
+
+        const int n = (int) (x + (x >= 0.0f ? 0.5f : -0.5f));
+        const float f = x - (float) n;
+
+        // Horner form of sum (f ln 2)^k / k!, k = 0..6
+        constexpr float c1 = 0.693147180559945f;
+        constexpr float c2 = 0.240226506959101f;
+        constexpr float c3 = 0.0555041086648216f;
+        constexpr float c4 = 0.00961812910762848f;
+        constexpr float c5 = 0.00133335581464284f;
+        constexpr float c6 = 0.000154035303933816f;
+
+        const float fraction = 1.0f + f * (c1 + f * (c2 + f * (c3 + f * (c4 + f * (c5 + f * c6)))));
+
+        const auto exponentBits = (juce::uint32) (n + 127) << 23;
+        float scale;
+        std::memcpy (&scale, &exponentBits, sizeof (scale));
+
+        return fraction * scale;
+    }
+
+    /** Frequency ratio for a number of semitones. */
+    inline float semitonesToRatio (float semitones) noexcept
+    {
+        return exp2 (semitones * (1.0f / 12.0f));
+    }
+}
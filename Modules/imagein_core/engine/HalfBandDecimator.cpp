@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "HalfBandDecimator.h"
+
+HalfBandDecimator::HalfBandDecimator()
+{
+    const auto& designs = getStageDesigns();
+
+    for (int stage = 0; stage < maxOrder; ++stage)
+        states[(size_t) stage].allpassStates.resize (designs[(size_t) stage].coefficients.size() * (size_t) maxChannels);
+}
+
+const std::array<HalfBandDecimator::StageDesign, HalfBandDecimator::maxOrder>& HalfBandDecimator::getStageDesigns()
+{
+    // Designed once, the first time a decimator is made, with juce::dsp::Oversampling's
+    // maximum-quality settings for its down path.
+    static const auto designs = []
+    {
+        std::array<StageDesign, maxOrder> result;
+
+        for (int stage = 0; stage < maxOrder; ++stage)
+        {
+            const float transitionWidth = 0.12f * (stage == 0 ? 0.5f : 1.0f);
+            const float stopbandDecibels = -70.0f + 10.0f * (float) stage;
+            const auto structure = juce::dsp::FilterDesign<float>::designIIRLowpassHalfBandPolyphaseAllpassMethod (transitionWidth, stopbandDecibels);
+
+            auto& design = result[(size_t) stage];
+
+            for (int i = 0; i < structure.directPath.size(); ++i)
+                design.coefficients.push_back (structure.directPath.getObjectPointer (i)->coefficients[0]);
+
+            design.numDirect = (int) design.coefficients.size();
+
+            // The delayed path starts with the one-sample delay, which process() applies itself.
+            for (int i = 1; i < structure.delayedPath.size(); ++i)
+                design.coefficients.push_back (structure.delayedPath.getObjectPointer (i)->coefficients[0]);
+        }
+
+        return result;
+    }();
+
+    return designs;
+}
+
+void HalfBandDecimator::reset() noexcept
+{
+    for (auto& state : states)
+    {
+        std::fill (state.allpassStates.begin(), state.allpassStates.end(), 0.0f);
+        std::fill (std::begin (state.delays), std::end (state.delays), 0.0f);
+    }
+}
+
+void HalfBandDecimator::process (float* const* channels, int numChannels, int numOutputSamples, int order) noexcept
+{
+    jassert (order <= maxOrder && numChannels <= maxChannels);
+    const auto& designs = getStageDesigns();
+
+    // The highest-rate stage goes first, as in juce::dsp::Oversampling.
+    for (int stage = order - 1; stage >= 0; --stage)
+    {
+        const auto& design = designs[(size_t) stage];
+        auto& state = states[(size_t) stage];
+        const float* coefficients = design.coefficients.data();
+        const int numCoefficients = (int) design.coefficients.size();
+        const int numSamples = numOutputSamples << stage;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* samples = channels[channel];
+            float* allpassStates = state.allpassStates.data() + channel * numCoefficients;
+            float delay = state.delays[channel];
+
+            // Output i is written once inputs 2i and 2i + 1 have been read, so this works in place.
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float input = samples[i << 1];
+
+                for (int n = 0; n < design.numDirect; ++n)
+                {
+                    const float output = coefficients[n] * input + allpassStates[n];
+                    allpassStates[n] = input - coefficients[n] * output;
+                    input = output;
+                }
+
+                const float directOut = input;
+                input = samples[(i << 1) + 1];
+
+                for (int n = design.numDirect; n < numCoefficients; ++n)
+                {
+                    const float output = coefficients[n] * input + allpassStates[n];
+                    allpassStates[n] = input - coefficients[n] * output;
+                    input = output;
+                }
+
+                samples[i] = (delay + directOut) * 0.5f;
+                delay = input;
+            }
+
+            state.delays[channel] = delay;
+
+            for (int n = 0; n < numCoefficients; ++n)
+                juce::dsp::util::snapToZero (allpassStates[n]);
+        }
+    }
+}
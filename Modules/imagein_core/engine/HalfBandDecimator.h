@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Brings a signal rendered at 2, 4 or 8 times the host rate back down to it,
+    through a cascade of polyphase IIR half-band filters. The filters are the
+    ones juce::dsp::Oversampling designs for filterHalfBandPolyphaseIIR at
+    maximum quality, so the result matches its processSamplesDown().
+
+    There is no upsampling half and no buffer: the readers generate their
+    signal at the high rate, so the caller renders it wherever it likes and
+    decimates it in place. A decimator only holds the filter states.
+*/
+class HalfBandDecimator
+{
+public:
+    static constexpr int maxOrder = 3;
+    static constexpr int maxChannels = 2;
+
+    HalfBandDecimator();
+
+    /** Clears the filter states. */
+    void reset() noexcept;
+
+    /** Decimates each channel in place by 2^order. The channels hold
+        numOutputSamples << order samples, and the result ends up in their
+        first numOutputSamples.
+    */
+    void process (float* const* channels, int numChannels, int numOutputSamples, int order) noexcept;
+
+private:
+    // One 2x stage: the allpass coefficients of its direct path, then those of its delayed path.
+    struct StageDesign
+    {
+        std::vector<float> coefficients;
+        int numDirect = 0;
+    };
+
+    struct StageState
+    {
+        std::vector<float> allpassStates; // coefficients.size() per channel
+        float delays[maxChannels] = {};
+    };
+
+    static const std::array<StageDesign, maxOrder>& getStageDesigns();
+
+    std::array<StageState, maxOrder> states; // index 0 is the stage next to the host rate
+
+    JUCE_LEAK_DETECTOR (HalfBandDecimator)
+};
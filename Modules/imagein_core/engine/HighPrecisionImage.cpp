@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+
+    HighPrecisionImage.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "HighPrecisionImage.h"
+
+namespace
+{
+    // Large enough for any terrain we can render, small enough that a corrupt header can't ask for gigabytes.
+    constexpr int maxDimension = 16384;
+
+    bool isSensibleSize (juce::uint32 width, juce::uint32 height)
+    {
+        return width > 0 && height > 0 && width <= (juce::uint32) maxDimension && height <= (juce::uint32) maxDimension;
+    }
+
+    juce::uint32 readBigEndian32 (const juce::uint8* p)
+    {
+        return ((juce::uint32) p[0] << 24) | ((juce::uint32) p[1] << 16) | ((juce::uint32) p[2] << 8) | (juce::uint32) p[3];
+    }
+
+    juce::uint8 paethPredictor (int a, int b, int c)
+    {
+        const int p = a + b - c;
+        const int pa = std::abs (p - a);
+        const int pb = std::abs (p - b);
+        const int pc = std::abs (p - c);
+
+        if (pa <= pb && pa <= pc)
+            return (juce::uint8) a;
+
+        return (juce::uint8) (pb <= pc ? b : c);
+    }
+
+    // Undoes the PNG filter of one scanline in place. previous is the already unfiltered line above, or nullptr.
+    bool unfilterPngLine (int filterType, juce::uint8* line, const juce::uint8* previous, size_t numBytes, size_t bytesPerPixel)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            const int left = i >= bytesPerPixel ? line[i - bytesPerPixel] : 0;
+            const int up = previous != nullptr ? previous[i] : 0;
+            const int upLeft = (previous != nullptr && i >= bytesPerPixel) ? previous[i - bytesPerPixel] : 0;
+
+            switch (filterType)
+            {
+                case 0:  break;
+                case 1:  line[i] = (juce::uint8) (line[i] + left); break;
+                case 2:  line[i] = (juce::uint8) (line[i] + up); break;
+                case 3:  line[i] = (juce::uint8) (line[i] + (left + up) / 2); break;
+                case 4:  line[i] = (juce::uint8) (line[i] + paethPredictor (left, up, upLeft)); break;
+                default: return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+HighPrecisionImage::HighPrecisionImage (int w, int h)
+    : width (w), height (h)
+{
+    values.allocate ((size_t) width * (size_t) height, true);
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::loadFrom (const juce::File& file)
+{
+    juce::MemoryBlock data;
+
+    if (! file.loadFileAsData (data))
+        return nullptr;
+
+    return loadFrom (data, file.hasFileExtension ("f32"));
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::loadFrom (const juce::MemoryBlock& data, bool isRawFloats)
+{
+    if (data.getSize() < 8)
+        return nullptr;
+
+    if (isRawFloats)
+        return loadRawFloats (data);
+
+    const auto* bytes = static_cast<const char*> (data.getData());
+
+    if (bytes[0] == 'P' && (bytes[1] == 'f' || bytes[1] == 'F'))
+        return loadPfm (data);
+
+    static const juce::uint8 pngSignature[] = { 0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a };
+
+    if (std::memcmp (bytes, pngSignature, sizeof (pngSignature)) == 0)
+        return loadPng (data);
+
+    return nullptr;
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::loadPng (const juce::MemoryBlock& data)
+{
+    const auto* bytes = static_cast<const juce::uint8*> (data.getData());
+    const size_t size = data.getSize();
+
+    juce::uint32 w = 0, h = 0;
+    int numChannels = 0;
+    juce::MemoryOutputStream compressed;
+
+    for (size_t pos = 8; pos + 12 <= size;)
+    {
+        const size_t length = readBigEndian32 (bytes + pos);
+        const auto* type = reinterpret_cast<const char*> (bytes + pos + 4);
+        const auto* chunk = bytes + pos + 8;
+
+        if (length > size - pos - 12)
+            return nullptr;
+
+        if (std::memcmp (type, "IHDR", 4) == 0)
+        {
+            if (length < 13)
+                return nullptr;
+
+            w = readBigEndian32 (chunk);
+            h = readBigEndian32 (chunk + 4);
+            const int bitDepth = chunk[8], colourType = chunk[9], interlace = chunk[12];
+
+            // Everything with 8 bits or less per channel is left to juce::PNGImageFormat.
+            if (bitDepth != 16 || interlace != 0 || ! isSensibleSize (w, h))
+                return nullptr;
+
+            switch (colourType)
+            {
+                case 0:  numChannels = 1; break; // grey
+                case 2:  numChannels = 3; break; // RGB
+                case 4:  numChannels = 2; break; // grey + alpha
+                case 6:  numChannels = 4; break; // RGBA
+                default: return nullptr;
+            }
+        }
+        else if (std::memcmp (type, "IDAT", 4) == 0)
+        {
+            compressed.write (chunk, length);
+        }
+        else if (std::memcmp (type, "IEND", 4) == 0)
+        {
+            break;
+        }
+
+        pos += length + 12;
+    }
+
+    if (numChannels == 0 || compressed.getDataSize() == 0)
+        return nullptr;
+
+    const size_t bytesPerPixel = (size_t) numChannels * 2;
+    const size_t lineBytes = (size_t) w * bytesPerPixel;
+
+    juce::MemoryInputStream compressedStream (compressed.getData(), compressed.getDataSize(), false);
+    juce::GZIPDecompressorInputStream inflater (compressedStream);
+
+    juce::HeapBlock<juce::uint8> lines (2 * lineBytes);
+    auto* line = lines.get();
+    juce::uint8* previous = nullptr;
+
+    Ptr result = new HighPrecisionImage ((int) w, (int) h);
+
+    for (int y = 0; y < (int) h; ++y)
+    {
+        juce::uint8 filterType = 0;
+
+        if (inflater.read (&filterType, 1) != 1
+             || inflater.read (line, (int) lineBytes) != (int) lineBytes
+             || ! unfilterPngLine (filterType, line, previous, lineBytes, bytesPerPixel))
+            return nullptr;
+
+        auto* dest = result->getLinePointer (y);
+
+        for (int x = 0; x < (int) w; ++x)
+        {
+            const auto* p = line + (size_t) x * bytesPerPixel;
+            auto sample = [p] (int channel) { return (float) ((p[2 * channel] << 8) | p[2 * channel + 1]) * (1.0f / 65535.0f); };
+
+            // Like the 8-bit path, which reads premultiplied pixels: transparent areas are dark.
+            switch (numChannels)
+            {
+                case 1:  dest[x] = sample (0); break;
+                case 2:  dest[x] = sample (0) * sample (1); break;
+                case 3:  dest[x] = juce::jmax (sample (0), sample (1), sample (2)); break;
+                default: dest[x] = juce::jmax (sample (0), sample (1), sample (2)) * sample (3); break;
+            }
+        }
+
+        // The line just decoded becomes the previous one, and the next is read into the other half.
+        previous = line;
+        line = (line == lines.get()) ? lines.get() + lineBytes : lines.get();
+    }
+
+    return result;
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::loadPfm (const juce::MemoryBlock& data)
+{
+    const auto* bytes = static_cast<const char*> (data.getData());
+    const size_t size = data.getSize();
+    size_t pos = 0;
+
+    // The header is three whitespace-separated tokens after the magic, followed by a single whitespace character.
+    auto nextToken = [&]
+    {
+        while (pos < size && juce::CharacterFunctions::isWhitespace (bytes[pos]))
+            ++pos;
+
+        const auto start = pos;
+
+        while (pos < size && ! juce::CharacterFunctions::isWhitespace (bytes[pos]))
+            ++pos;
+
+        return juce::String (bytes + start, pos - start);
+    };
+
+    const auto magic = nextToken();
+    const int numChannels = magic == "PF" ? 3 : (magic == "Pf" ? 1 : 0);
+    const auto w = nextToken().getLargeIntValue();
+    const auto h = nextToken().getLargeIntValue();
+    const auto scale = nextToken().getDoubleValue();
+    ++pos;
+
+    if (numChannels == 0 || w <= 0 || h <= 0 || ! isSensibleSize ((juce::uint32) w, (juce::uint32) h) || scale == 0.0)
+        return nullptr;
+
+    // A negative scale means little-endian data.
+    const bool littleEndian = scale < 0.0;
+    const size_t floatsPerLine = (size_t) w * (size_t) numChannels;
+
+    if (pos > size || size - pos < floatsPerLine * (size_t) h * sizeof (float))
+        return nullptr;
+
+    Ptr result = new HighPrecisionImage ((int) w, (int) h);
+
+    for (int y = 0; y < (int) h; ++y)
+    {
+        // Lines are stored from the bottom of the image up.
+        const auto* src = bytes + pos + (size_t) ((int) h - 1 - y) * floatsPerLine * sizeof (float);
+        auto* dest = result->getLinePointer (y);
+
+        for (int x = 0; x < (int) w; ++x)
+        {
+            float brightness = 0.0f;
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                const auto* p = src + ((size_t) x * (size_t) numChannels + (size_t) c) * sizeof (float);
+                const auto raw = littleEndian ? juce::ByteOrder::littleEndianInt (p) : juce::ByteOrder::bigEndianInt (p);
+                float value;
+                std::memcpy (&value, &raw, sizeof (float));
+
+                brightness = c == 0 ? value : juce::jmax (brightness, value);
+            }
+
+            dest[x] = std::isfinite (brightness) ? juce::jlimit (0.0f, 1.0f, brightness) : 0.0f;
+        }
+    }
+
+    return result;
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::loadRawFloats (const juce::MemoryBlock& data)
+{
+    // No header: the file must hold exactly size * size floats.
+    const size_t numValues = data.getSize() / sizeof (float);
+    const auto side = (size_t) std::llround (std::sqrt ((double) numValues));
+
+    if (data.getSize() % sizeof (float) != 0 || side * side != numValues || ! isSensibleSize ((juce::uint32) side, (juce::uint32) side))
+        return nullptr;
+
+    Ptr result = new HighPrecisionImage ((int) side, (int) side);
+    const auto* src = static_cast<const char*> (data.getData());
+
+    for (int y = 0; y < (int) side; ++y)
+    {
+        auto* dest = result->getLinePointer (y);
+
+        for (int x = 0; x < (int) side; ++x)
+        {
+            const auto raw = juce::ByteOrder::littleEndianInt (src + ((size_t) y * side + (size_t) x) * sizeof (float));
+            float value;
+            std::memcpy (&value, &raw, sizeof (float));
+            dest[x] = std::isfinite (value) ? juce::jlimit (0.0f, 1.0f, value) : 0.0f;
+        }
+    }
+
+    return result;
+}
+
+HighPrecisionImage::Ptr HighPrecisionImage::makeSquare (const std::function<bool()>& shouldAbort)
+{
+    if (width == height)
+        return this;
+
+    const int finalSize = juce::jmax (width, height);
+    Ptr square = new HighPrecisionImage (finalSize, finalSize);
+
+    // The same layout ImageBuffer draws for 8-bit images: the image in the centre, mirrored
+    // once on both sides, and anything beyond that mirror left black.
+    if (width > height) // Landscape image
+    {
+        const int yOffset = (finalSize - height) / 2;
+
+        for (int y = 0; y < finalSize; ++y)
+        {
+            if (shouldAbort != nullptr && shouldAbort())
+                return nullptr;
+
+            int sourceY = y - yOffset;
+
+            if (sourceY < 0)
+                sourceY = -1 - sourceY;
+            else if (sourceY >= height)
+                sourceY = 2 * height - 1 - sourceY;
+
+            if (juce::isPositiveAndBelow (sourceY, height))
+                std::copy (getLinePointer (sourceY), getLinePointer (sourceY) + width, square->getLinePointer (y));
+        }
+    }
+    else // Portrait image
+    {
+        const int xOffset = (finalSize - width) / 2;
+
+        for (int y = 0; y < finalSize; ++y)
+        {
+            if (shouldAbort != nullptr && shouldAbort())
+                return nullptr;
+
+            const auto* src = getLinePointer (y);
+            auto* dest = square->getLinePointer (y);
+
+            for (int x = 0; x < finalSize; ++x)
+            {
+                int sourceX = x - xOffset;
+
+                if (sourceX < 0)
+                    sourceX = -1 - sourceX;
+                else if (sourceX >= width)
+                    sourceX = 2 * width - 1 - sourceX;
+
+                if (juce::isPositiveAndBelow (sourceX, width))
+                    dest[x] = src[sourceX];
+            }
+        }
+    }
+
+    return square;
+}
+
+juce::Image HighPrecisionImage::createPreview() const
+{
+    juce::Image preview (juce::Image::ARGB, width, height, false);
+    juce::Image::BitmapData bitmapData (preview, juce::Image::BitmapData::writeOnly);
+
+    for (int y = 0; y < height; ++y)
+    {
+        const auto* src = getLinePointer (y);
+
+        for (int x = 0; x < width; ++x)
+        {
+            const auto grey = (juce::uint8) juce::roundToInt (src[x] * 255.0f);
+            bitmapData.setPixelColour (x, y, juce::Colour (grey, grey, grey));
+        }
+    }
+
+    return preview;
+}
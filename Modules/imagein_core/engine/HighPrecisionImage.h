@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    HighPrecisionImage.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    The brightness of an image decoded at more than 8 bits, for terrains whose
+    smooth slopes would otherwise play as audible steps.
+
+    juce::ImageFileFormat always decodes to 8-bit ARGB. This reads the files it
+    would quantise straight to floats instead:
+      - 16-bit PNG (grey, grey + alpha, RGB or RGBA; not interlaced)
+      - PFM, grey ("Pf") or colour ("PF")
+      - raw .f32: square, little-endian 32-bit floats, row by row from the top
+
+    Brightness is max(r, g, b) in [0, 1], as for 8-bit images. Once built it is
+    never modified, so it can be shared between threads.
+*/
+class HighPrecisionImage : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<HighPrecisionImage>;
+
+    HighPrecisionImage (int width, int height);
+
+    /** Decodes a file if it is in one of the formats above, or returns nullptr.
+        8-bit files also return nullptr: juce::ImageFileFormat reads them exactly.
+    */
+    static Ptr loadFrom (const juce::File& file);
+
+    /** The same, for a file already read into memory. Raw floats have no header,
+        so the caller says whether the data is a .f32 file.
+    */
+    static Ptr loadFrom (const juce::MemoryBlock& data, bool isRawFloats);
+
+    /** Pads a non-square image to a square by mirroring it, as ImageBuffer does
+        with 8-bit images. Returns this image if it is square already, and nullptr
+        if shouldAbort returned true part way.
+    */
+    Ptr makeSquare (const std::function<bool()>& shouldAbort = {});
+
+    /** An 8-bit greyscale copy, for display. */
+    juce::Image createPreview() const;
+
+    int getWidth() const noexcept  { return width; }
+    int getHeight() const noexcept { return height; }
+
+    const float* getLinePointer (int y) const noexcept { return values.get() + (size_t) y * (size_t) width; }
+    float* getLinePointer (int y) noexcept              { return values.get() + (size_t) y * (size_t) width; }
+
+private:
+    static Ptr loadPng (const juce::MemoryBlock& data);
+    static Ptr loadPfm (const juce::MemoryBlock& data);
+    static Ptr loadRawFloats (const juce::MemoryBlock& data);
+
+    const int width, height;
+    juce::HeapBlock<float> values;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighPrecisionImage)
+};
@@ -29,10 +29,33 @@ void ImageBuffer::setImage (const juce::Image& newImage)
         const juce::ScopedLock lock (imageLock);
         sourceFile = juce::File();
         image = {};
+        highPrecisionImage = nullptr;
         sendChangeMessage();
         return;
     }
 
+    auto processedImage = makeSquare (newImage);
+
+    const juce::ScopedLock lock (imageLock);
+    image = processedImage;    
+    sourceFile = juce::File(); // An image from memory has no source file path
+    highPrecisionImage = nullptr;
+    sendChangeMessage();
+}
+
+void ImageBuffer::setSquareImage (const juce::Image& squareImage, HighPrecisionImage::Ptr squareHighPrecisionImage, const juce::File& imageFile)
+{
+    jassert (squareImage.getWidth() == squareImage.getHeight());
+
+    const juce::ScopedLock lock (imageLock);
+    image = squareImage;
+    highPrecisionImage = std::move (squareHighPrecisionImage);
+    sourceFile = imageFile;
+    sendChangeMessage();
+}
+
+juce::Image ImageBuffer::makeSquare (const juce::Image& newImage)
+{
     juce::Image processedImage;
     const int w = newImage.getWidth();
     const int h = newImage.getHeight();
@@ -95,24 +118,33 @@ void ImageBuffer::setImage (const juce::Image& newImage)
         }
     }
 
-    const juce::ScopedLock lock (imageLock);
-    image = processedImage;    
-    sourceFile = juce::File(); // An image from memory has no source file path
-    sendChangeMessage();
+    return processedImage;
 }
 
 bool ImageBuffer::setImage (const juce::File& imageFile)
 {
+    // 16-bit and float files are also decoded at full precision for the readers.
+    // The display keeps JUCE's 8-bit decoding when it can read the file, which
+    // preserves colour, and a grey preview of the precise image otherwise.
+    auto precise = HighPrecisionImage::loadFrom (imageFile);
     juce::Image newImage = juce::ImageFileFormat::loadFrom (imageFile);
 
+    if (! newImage.isValid() && precise != nullptr)
+        newImage = precise->createPreview();
+
     if (newImage.isValid())
     {
         // This will process the image and also clear the sourceFile path
         setImage (newImage);
 
-        // We restore the path immediately after
+        // We restore the path immediately after. Listeners are called asynchronously,
+        // so they see the precise image along with the new one.
         const juce::ScopedLock lock (imageLock);
         sourceFile = imageFile;
+
+        if (precise != nullptr)
+            highPrecisionImage = precise->makeSquare();
+
         return true;
     }
 
@@ -128,4 +160,17 @@ juce::File ImageBuffer::getFile() const
 {
     const juce::ScopedLock lock (imageLock);
     return sourceFile;
+}
+
+HighPrecisionImage::Ptr ImageBuffer::getHighPrecisionImage() const
+{
+    const juce::ScopedLock lock (imageLock);
+    return highPrecisionImage;
+}
+
+void ImageBuffer::getContent (juce::Image& imageResult, HighPrecisionImage::Ptr& highPrecisionResult) const
+{
+    const juce::ScopedLock lock (imageLock);
+    imageResult = image;
+    highPrecisionResult = highPrecisionImage;
 }
\ No newline at end of file
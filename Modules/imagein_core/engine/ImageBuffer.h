@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    ImageBuffer.h
+    Created: 12 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "HighPrecisionImage.h"
+
+/**
+    This class holds a juce::Image and provides thread-safe access to it.
+    It acts as a ChangeBroadcaster to notify listeners when the image is updated.
+
+    Files with more than 8 bits per channel also keep a HighPrecisionImage, which
+    the readers use instead of the 8-bit image shown on screen.
+*/
+class ImageBuffer : public juce::ChangeBroadcaster
+{
+public:
+    ImageBuffer();
+    ~ImageBuffer() override;
+
+    void setImage (const juce::Image& newImage);
+
+    /** Decodes the file on the calling thread. The plugin goes through ImageLoader instead. */
+    bool setImage (const juce::File& imageFile);
+
+    /** Takes images that are already square, as prepared by ImageLoader, without processing them again. */
+    void setSquareImage (const juce::Image& squareImage, HighPrecisionImage::Ptr squareHighPrecisionImage, const juce::File& imageFile);
+
+    /** Pads a non-square image to a square, mirroring it on both sides. Can be called from any thread. */
+    static juce::Image makeSquare (const juce::Image& image);
+    juce::Image getImage() const;
+    juce::File getFile() const;
+
+    /** The full-precision version of the image, or nullptr if it came from an 8-bit file or from memory. */
+    HighPrecisionImage::Ptr getHighPrecisionImage() const;
+
+    /** Gets both images under a single lock, so they always match. */
+    void getContent (juce::Image& imageResult, HighPrecisionImage::Ptr& highPrecisionResult) const;
+
+private:
+    juce::Image image;
+    HighPrecisionImage::Ptr highPrecisionImage;
+    juce::File sourceFile;
+    juce::CriticalSection imageLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageBuffer)
+};
\ No newline at end of file
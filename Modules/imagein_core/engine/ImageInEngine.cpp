@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    ImageInEngine.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "ImageInEngine.h"
+
+ImageInEngine::ImageInEngine()
+{
+    renderScratch[0] = std::make_unique<SynthVoice::RenderScratch>();
+
+    for (int synthIndex = 0; synthIndex < numSynths; ++synthIndex)
+    {
+        auto& synth = synths[(size_t) synthIndex];
+        synth.addSound (new SynthSound());
+
+        for (int i = 0; i < MAX_VOICES; ++i)
+        {
+            auto* voice = new SynthVoice (*this, i, synthIndex);
+            voice->rebuildReaders ({ ReaderBase::Type::Ellipse }); // Only one reader type per synth
+            synth.addVoice (voice);
+        }
+    }
+}
+
+ImageInEngine::~ImageInEngine()
+{
+    cancelPendingUpdate();
+}
+
+void ImageInEngine::prepare (double newSampleRate, int newMaximumBlockSize, int numChannels)
+{
+    sampleRate = newSampleRate;
+
+    for (auto& synth : synths)
+    {
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            static_cast<SynthVoice*> (synth.getVoice (i))->prepare (newMaximumBlockSize, numChannels);
+    }
+
+    lfoBuffer.setSize (numLfos, newMaximumBlockSize);
+    midiRouter.prepare (8192);
+
+    for (auto& synthBuffer : synthBuffers)
+        synthBuffer.setSize (numChannels, newMaximumBlockSize);
+
+    {
+        const juce::ScopedLock sl (renderPoolCreationLock);
+        maximumBlockSize = newMaximumBlockSize;
+
+        for (auto& scratch : renderScratch)
+            if (scratch != nullptr)
+                scratch->prepare (maximumBlockSize, sampleRate);
+    }
+
+    if (multiThreaded)
+        createRenderPool();
+
+    for (auto& lfo : lfos)
+        lfo.prepareToPlay (sampleRate);
+
+    for (auto& loopWavetable : loopWavetables)
+        loopWavetable.invalidate();
+
+    outputLevel.reset (sampleRate, 0.05);
+    dcFilterInputs.assign ((size_t) numChannels, 0.0f);
+    dcFilterOutputs.assign ((size_t) numChannels, 0.0f);
+}
+
+void ImageInEngine::setMultiThreaded (bool shouldRenderInParallel)
+{
+    multiThreaded = shouldRenderInParallel;
+
+    if (auto* pool = renderPool.load())
+        pool->setKeepWorkersAwake (shouldRenderInParallel);
+
+    if (! shouldRenderInParallel || renderPool.load() != nullptr)
+        return;
+
+    // Starting threads is no job for the audio thread.
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        createRenderPool();
+    else
+        triggerAsyncUpdate();
+}
+
+void ImageInEngine::createRenderPool()
+{
+    const juce::ScopedLock sl (renderPoolCreationLock);
+
+    // Spawned once and kept; the workers sleep while multi-threaded rendering is off.
+    if (ownedRenderPool == nullptr)
+    {
+        ownedRenderPool = std::make_unique<RenderThreadPool> (juce::jlimit (1, RenderThreadPool::maxWorkers, juce::SystemStats::getNumCpus() - 1));
+
+        // The workers' scratch must be ready before process() can see the pool.
+        for (int i = 1; i <= ownedRenderPool->getNumWorkers(); ++i)
+        {
+            renderScratch[(size_t) i] = std::make_unique<SynthVoice::RenderScratch>();
+            renderScratch[(size_t) i]->prepare (maximumBlockSize, sampleRate);
+        }
+
+        ownedRenderPool->setKeepWorkersAwake (multiThreaded);
+        renderPool.store (ownedRenderPool.get());
+    }
+}
+
+SynthVoice::RenderScratch& ImageInEngine::getRenderScratch() noexcept
+{
+    const auto* pool = renderPool.load();
+    return *renderScratch[(size_t) (pool != nullptr ? pool->getCurrentThreadIndex() : 0)];
+}
+
+void ImageInEngine::handleAsyncUpdate()
+{
+    createRenderPool();
+}
+
+void ImageInEngine::setOutputLevel (float decibels)
+{
+    outputLevel.setTargetValue (juce::Decibels::decibelsToGain (decibels));
+}
+
+void ImageInEngine::setLfo (int index, LFO::Waveform waveform, float frequencyHz, float phaseOffset)
+{
+    auto& lfo = lfos[(size_t) index];
+    lfo.setWaveform (waveform);
+    lfo.setFrequency (frequencyHz);
+    lfo.setPhaseOffset (phaseOffset);
+}
+
+void ImageInEngine::process (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages)
+{
+    buffer.clear();
+
+    // Split MIDI buffer by channel for each synth
+    midiRouter.route (midiMessages, { globalParams.ellipses[0].midiChannel,
+                                      globalParams.ellipses[1].midiChannel,
+                                      globalParams.ellipses[2].midiChannel });
+
+    const int numSamples = buffer.getNumSamples();
+
+    // Process LFOs for the block
+    for (int lfoIndex = 0; lfoIndex < numLfos; ++lfoIndex)
+    {
+        auto& lfo = lfos[(size_t) lfoIndex];
+        auto* lfoData = lfoBuffer.getWritePointer (lfoIndex);
+
+        for (int i = 0; i < numSamples; ++i)
+            lfoData[i] = lfo.process();
+    }
+
+    // Each synth renders into its own buffer, summed below in synth order, so the
+    // output is the same whether or not the synths and voices run in parallel.
+    auto* pool = multiThreaded ? renderPool.load() : nullptr;
+
+    auto renderSynth = [&] (int i)
+    {
+        if (! globalParams.ellipses[i].on)
+            return;
+
+        auto& synthBuffer = synthBuffers[(size_t) i];
+        synthBuffer.setSize (buffer.getNumChannels(), numSamples, false, false, true);
+        synthBuffer.clear();
+        synths[(size_t) i].setThreadPool (pool);
+        synths[(size_t) i].setPolyphony (globalParams.polyphony);
+
+        // Built here, before any voice of the synth renders, if one asked for it last block.
+        {
+            const BitmapDataManager::ScopedAccess pyramid (bitmapDataManager);
+
+            if (pyramid.get() != nullptr)
+                loopWavetables[(size_t) i].update (*pyramid.get(), EllipseReader::getSettledGeometry (globalParams.ellipses[i]));
+        }
+
+        synths[(size_t) i].renderNextBlock (synthBuffer, midiRouter.getEventsFor (i), 0, numSamples);
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor (numSynths, renderSynth);
+    else
+        for (int i = 0; i < numSynths; ++i)
+            renderSynth (i);
+
+    for (int i = 0; i < numSynths; ++i)
+    {
+        const auto& params = globalParams.ellipses[i];
+        if (params.on)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.addFrom (ch, 0, synthBuffers[(size_t) i], ch, 0, numSamples);
+        }
+        else if (params.wasOn) // It was on, but now it's off
+        {
+            // Released rather than cut: a cut would render declick tails that the
+            // synth, now off, never plays. The ADSRs are then reset, silencing it at once.
+            synths[(size_t) i].allNotesOff (0, true);
+
+            // Manually update the display state and reset the ADSRs for the voices of the turned-off synth
+            for (int voiceIndex = 0; voiceIndex < MAX_VOICES; ++voiceIndex)
+            {
+                if (auto* voice = getVoice (i, voiceIndex))
+                {
+                    voice->resetADSRs();
+                    voice->publishInactiveDisplayState();
+                }
+            }
+        }
+    }
+
+    outputLevel.applyGain (buffer, numSamples);
+    applyDcFilter (buffer);
+}
+
+void ImageInEngine::applyDcFilter (juce::AudioBuffer<float>& buffer)
+{
+    // One-pole RC high-pass at 15 Hz
+    constexpr float cutoffFreq = 15.0f;
+    const int numChannels = juce::jmin (buffer.getNumChannels(), (int) dcFilterInputs.size());
+    const int numSamples = buffer.getNumSamples();
+
+    float RC = 1.0f / (juce::MathConstants<float>::twoPi * cutoffFreq);
+    float dt = (float) (1.0f / sampleRate);
+    float alpha = RC / (RC + dt);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* channelData = buffer.getWritePointer (channel);
+        float prevInput = dcFilterInputs[(size_t) channel];
+        float prevOutput = dcFilterOutputs[(size_t) channel];
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float input = channelData[n];
+            channelData[n] = alpha * (prevOutput + input - prevInput);
+            prevOutput = channelData[n];
+            prevInput = input;
+        }
+
+        dcFilterInputs[(size_t) channel] = prevInput;
+        dcFilterOutputs[(size_t) channel] = prevOutput;
+    }
+}
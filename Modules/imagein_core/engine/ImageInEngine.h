@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ImageInEngine.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterStructs.h"
+#include "LFO.h"
+#include "ImageBuffer.h"
+#include "BitmapDataManager.h"
+#include "ImageLoader.h"
+#include "TripleBuffer.h"
+#include "RenderThreadPool.h"
+#include "MidiRouter.h"
+#include "SynthVoice.h"
+#include "MapSynthesiser.h"
+
+// Voices allocated per synth; the Polyphony parameter picks how many are used
+#define MAX_VOICES 64
+
+// What the map display draws for one voice. Plain data, so it can go through a TripleBuffer.
+struct VoiceDisplayState
+{
+    static constexpr int maxReaders = 4;
+
+    bool isActive = false;
+    int numReaders = 0;
+    ReaderBase::DrawingInfo readerInfos[maxReaders];
+};
+
+/**
+    The sound engine on its own: the image, the three ellipse synths with their
+    voices, the LFOs the voices share and the output stage (master level and DC
+    filter). It knows nothing of plugin parameters, presets or the GUI.
+
+    Whoever owns it fills globalParams and sets the LFOs between blocks, then
+    calls process(). The plugin does this from its parameters, the tools directly.
+*/
+class ImageInEngine : private juce::AsyncUpdater
+{
+public:
+    static constexpr int numSynths = 3;
+    static constexpr int numLfos = 4;
+
+    /** How long the releases can ring after the last note off. */
+    static constexpr double tailLengthSeconds = 5.0;
+
+    ImageInEngine();
+    ~ImageInEngine() override;
+
+    /** Call before the first process(), and whenever the rate or block size change. */
+    void prepare (double sampleRate, int maximumBlockSize, int numChannels);
+
+    /** Sets one of the LFOs shared by every voice. Cheap to call every block. */
+    void setLfo (int index, LFO::Waveform waveform, float frequencyHz, float phaseOffset);
+
+    /** The master level, applied to the sum of the synths. Smoothed over 50 ms. */
+    void setOutputLevel (float decibels);
+
+    /** Renders the synths and their voices on a pool of worker threads when on.
+        The workers are only started the first time it is turned on: at once on the
+        message thread, otherwise asynchronously, rendering on the calling thread
+        until they are ready. Realtime-safe.
+    */
+    void setMultiThreaded (bool shouldRenderInParallel);
+
+    /** Replaces the content of buffer by the next block of the three synths, at the output level. */
+    void process (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages);
+
+    /** The last value an LFO produced, for display. */
+    float getLfoValue (int index) const { return lfos[(size_t) index].getLatestValue(); }
+
+    SynthVoice* getVoice (int synthIndex, int voiceIndex) const { return dynamic_cast<SynthVoice*> (synths[(size_t) synthIndex].getVoice (voiceIndex)); }
+
+    /** The loop wavetable the voices of a synth share. */
+    SharedLoopWavetable& getLoopWavetable (int synthIndex) noexcept { return loopWavetables[(size_t) synthIndex]; }
+
+    /** The scratch buffers of whichever voice renders on the calling thread. */
+    SynthVoice::RenderScratch& getRenderScratch() noexcept;
+
+    ImageBuffer imageBuffer;
+    BitmapDataManager bitmapDataManager { imageBuffer };
+    ImageLoader imageLoader { imageBuffer, bitmapDataManager };
+
+    // Read by the voices as they render: only change it between blocks.
+    GlobalParameters globalParams;
+    juce::AudioBuffer<float> lfoBuffer;
+
+    // Written by each voice as it renders, read by the map display.
+    std::array<std::array<TripleBuffer<VoiceDisplayState>, MAX_VOICES>, numSynths> voiceDisplayStates;
+
+private:
+    void applyDcFilter (juce::AudioBuffer<float>& buffer);
+    void createRenderPool();
+    void handleAsyncUpdate() override;
+
+    std::array<LFO, numLfos> lfos;
+    std::array<SharedLoopWavetable, numSynths> loopWavetables; // Before the synths, whose voices point to them
+    std::array<MapSynthesiser, numSynths> synths;
+    std::array<juce::AudioBuffer<float>, numSynths> synthBuffers;
+    std::unique_ptr<RenderThreadPool> ownedRenderPool;
+    std::atomic<RenderThreadPool*> renderPool { nullptr }; // What process() reads
+    juce::CriticalSection renderPoolCreationLock;
+
+    // One set per thread that can render voices: 0 for the calling thread, then one per worker.
+    std::array<std::unique_ptr<SynthVoice::RenderScratch>, RenderThreadPool::maxWorkers + 1> renderScratch;
+    int maximumBlockSize = 0;
+    MidiRouter midiRouter;
+    std::atomic<bool> multiThreaded { false };
+
+    double sampleRate = 44100.0;
+    juce::LinearSmoothedValue<float> outputLevel;
+    std::vector<float> dcFilterInputs, dcFilterOutputs; // last sample of each channel
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageInEngine)
+};
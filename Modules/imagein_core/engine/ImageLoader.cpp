@@ -0,0 +1,429 @@
+/*
+  ==============================================================================
+
+    ImageLoader.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "ImageLoader.h"
+
+class ImageLoader::LoadJob : public juce::ThreadPoolJob
+{
+public:
+    LoadJob (ImageLoader& loaderToReportTo, const juce::File& fileToLoad, juce::MemoryBlock encodedImage)
+        : juce::ThreadPoolJob ("Image load"),
+          loader (loaderToReportTo),
+          file (fileToLoad),
+          encodedData (std::move (encodedImage))
+    {
+    }
+
+    juce::uint32 generation = 0;
+
+    JobStatus runJob() override
+    {
+        if (file != juce::File())
+        {
+            // Large images were saved preprocessed the first time; map that instead of decoding again.
+            sourceIdentity = TerrainFile::getSourceIdentity (file);
+            const auto terrainFile = TerrainFile::getCacheFileFor (sourceIdentity);
+
+            if (terrainFile.existsAsFile())
+            {
+                auto terrain = loader.terrainCache->getOrCreate (TerrainCache::makeKey (&sourceIdentity, sizeof (sourceIdentity), mapTerrainFile),
+                                                                 [this, &terrainFile] { return openTerrainFile (terrainFile); },
+                                                                 [this] { return shouldExit(); });
+
+                if (shouldExit())
+                    return jobHasFinished;
+
+                // Otherwise it is out of date or damaged, and is written again below.
+                if (terrain != nullptr)
+                {
+                    loader.jobFinished (generation, std::move (terrain));
+                    return jobHasFinished;
+                }
+            }
+
+            if (! file.loadFileAsData (encodedData))
+            {
+                loader.jobFinished (generation, nullptr);
+                return jobHasFinished;
+            }
+        }
+
+        // Raw floats have no header, so the same bytes read as a PNG would be another terrain.
+        const bool isRawFloats = file.hasFileExtension ("f32");
+        const auto key = TerrainCache::makeKey (encodedData.getData(), encodedData.getSize(), isRawFloats ? decodeRawFloats : decodeImage);
+
+        if (! reportProgress (0.1f))
+            return jobHasFinished;
+
+        auto terrain = loader.terrainCache->getOrCreate (key,
+                                                         [this, isRawFloats] { return createTerrain (isRawFloats); },
+                                                         [this] { return shouldExit(); });
+
+        if (shouldExit())
+            return jobHasFinished;
+
+        loader.jobFinished (generation, terrain);
+
+        // Saved once it is published, so that the next load can map it. The mapped file then
+        // stands in for the built terrain, which would otherwise stay in memory beside it.
+        if (builtTerrain != nullptr && file != juce::File() && builtTerrain->image.getWidth() >= TerrainFile::minimumSizeToSave
+             && saveTerrainFile (*builtTerrain))
+        {
+            if (auto mapped = openTerrainFile (TerrainFile::getCacheFileFor (sourceIdentity)))
+            {
+                loader.terrainCache->replace (*builtTerrain, mapped, TerrainCache::makeKey (&sourceIdentity, sizeof (sourceIdentity), mapTerrainFile));
+                loader.jobMappedTerrain (generation, builtTerrain, mapped);
+            }
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    // What the TerrainCache keys say about how a terrain was made.
+    enum PreparationSettings : juce::uint32
+    {
+        decodeImage = 0,
+        decodeRawFloats = 1,
+        mapTerrainFile = 2
+    };
+
+    static constexpr int maxPreviewSize = 2048;
+    static constexpr juce::int64 maxTerrainFolderBytes = (juce::int64) 16 * 1024 * 1024 * 1024;
+
+    Terrain::Ptr openTerrainFile (const juce::File& terrainFile)
+    {
+        auto mapped = TerrainFile::open (terrainFile, sourceIdentity);
+
+        if (mapped == nullptr)
+            return nullptr;
+
+        auto preview = mapped->loadPreview();
+
+        if (! preview.isValid())
+            return nullptr;
+
+        // The folder is pruned by date, oldest first.
+        terrainFile.setLastModificationTime (juce::Time::getCurrentTime());
+        return new Terrain (preview, std::move (mapped));
+    }
+
+    bool saveTerrainFile (const Terrain& terrain)
+    {
+        const int previewSize = juce::jmin (maxPreviewSize, terrain.image.getWidth());
+        const auto preview = terrain.image.rescaled (previewSize, previewSize, juce::Graphics::mediumResamplingQuality);
+
+        TerrainFile::Metadata metadata;
+        metadata.originalWidth = originalWidth;
+        metadata.originalHeight = originalHeight;
+        metadata.sourceIdentity = sourceIdentity;
+
+        if (! TerrainFile::write (TerrainFile::getCacheFileFor (sourceIdentity), terrain.snapshot->pyramid,
+                                  preview, metadata, [this] { return shouldExit(); }))
+            return false;
+
+        TerrainFile::pruneCacheFolder (maxTerrainFolderBytes);
+        return true;
+    }
+
+    Terrain::Ptr createTerrain (bool isRawFloats)
+    {
+        // Decode. 16-bit and float files also get a full-precision copy for the readers.
+        auto highPrecisionImage = HighPrecisionImage::loadFrom (encodedData, isRawFloats);
+
+        if (shouldExit())
+            return nullptr;
+
+        auto image = isRawFloats ? juce::Image() : juce::ImageFileFormat::loadFrom (encodedData.getData(), encodedData.getSize());
+
+        if (! image.isValid() && highPrecisionImage != nullptr)
+            image = highPrecisionImage->createPreview();
+
+        if (! image.isValid() || ! reportProgress (0.4f))
+            return nullptr;
+
+        originalWidth = image.getWidth();
+        originalHeight = image.getHeight();
+
+        // Pad to a square
+        image = ImageBuffer::makeSquare (image);
+
+        if (highPrecisionImage != nullptr)
+            highPrecisionImage = highPrecisionImage->makeSquare ([this] { return shouldExit(); });
+
+        if (! reportProgress (0.5f))
+            return nullptr;
+
+        // Brightness plane and mips, which take the rest of the progress, level by level
+        Terrain::Ptr terrain = new Terrain (image, std::move (highPrecisionImage),
+                                            [this] (float pyramidProgress) { return reportProgress (0.5f + 0.5f * pyramidProgress); });
+
+        if (! terrain->snapshot->pyramid.isValid())
+            return nullptr;
+
+        builtTerrain = terrain;
+        return builtTerrain;
+    }
+
+    // Returns false once the job has been cancelled.
+    bool reportProgress (float progress)
+    {
+        if (shouldExit())
+            return false;
+
+        loader.jobProgressChanged (generation, progress);
+        return true;
+    }
+
+    ImageLoader& loader;
+    const juce::File file;
+    juce::MemoryBlock encodedData;
+    juce::uint64 sourceIdentity = 0;
+    Terrain::Ptr builtTerrain;
+    int originalWidth = 0, originalHeight = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadJob)
+};
+
+//==============================================================================
+ImageLoader::ImageLoader (ImageBuffer& bufferToLoadInto, BitmapDataManager& managerToPublishTo)
+    : imageBuffer (bufferToLoadInto),
+      bitmapDataManager (managerToPublishTo)
+{
+    imageBuffer.addChangeListener (this);
+}
+
+ImageLoader::~ImageLoader()
+{
+    imageBuffer.removeChangeListener (this);
+
+    if (pool != nullptr)
+        pool->removeAllJobs (true, 10000);
+
+    cancelPendingUpdate();
+    releasePublishedTerrain();
+}
+
+void ImageLoader::loadAsync (const juce::File& imageFile)
+{
+    startJob (new LoadJob (*this, imageFile, {}), imageFile);
+}
+
+void ImageLoader::loadAsync (const void* encodedData, size_t dataSize)
+{
+    startJob (new LoadJob (*this, {}, juce::MemoryBlock (encodedData, dataSize)), {});
+}
+
+void ImageLoader::startJob (LoadJob* job, const juce::File& file)
+{
+    const juce::ScopedLock sl (lock);
+
+    // A single thread: loads never compete with each other for memory bandwidth,
+    // and a new one only starts once the cancelled one has noticed.
+    if (pool == nullptr)
+        pool = std::make_unique<juce::ThreadPool> (1);
+
+    pool->removeAllJobs (true, 0);
+
+    job->generation = ++currentGeneration;
+    loading = true;
+    requestedFile = file;
+    latestProgress = 0.0f;
+    progressPending = true;
+    resultPending = false;
+    finishedTerrain = nullptr;
+    terrainToSwapOut = nullptr;
+    swappedInTerrain = nullptr;
+
+    pool->addJob (job, true);
+    triggerAsyncUpdate();
+}
+
+void ImageLoader::cancel()
+{
+    const juce::ScopedLock sl (lock);
+
+    if (pool != nullptr)
+        pool->removeAllJobs (true, 0);
+
+    if (loading)
+    {
+        cancellationPending = true;
+        cancelledFile = requestedFile;
+        triggerAsyncUpdate();
+    }
+
+    ++currentGeneration;
+    loading = false;
+    requestedFile = juce::File();
+    progressPending = false;
+    resultPending = false;
+    finishedTerrain = nullptr;
+    terrainToSwapOut = nullptr;
+    swappedInTerrain = nullptr;
+}
+
+bool ImageLoader::isLoading() const
+{
+    const juce::ScopedLock sl (lock);
+    return loading;
+}
+
+juce::File ImageLoader::getFile() const
+{
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (loading)
+            return requestedFile;
+    }
+
+    return imageBuffer.getFile();
+}
+
+bool ImageLoader::waitForPendingLoads (int timeOutMilliseconds)
+{
+    const auto startTime = juce::Time::getMillisecondCounter();
+
+    while (pool != nullptr && pool->getNumJobs() > 0)
+    {
+        if (timeOutMilliseconds >= 0 && juce::Time::getMillisecondCounter() - startTime > (juce::uint32) timeOutMilliseconds)
+            return false;
+
+        juce::Thread::sleep (1);
+    }
+
+    handleUpdateNowIfNeeded();
+    return true;
+}
+
+void ImageLoader::jobProgressChanged (juce::uint32 generation, float progress)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (generation != currentGeneration)
+        return;
+
+    latestProgress = progress;
+    progressPending = true;
+    triggerAsyncUpdate();
+}
+
+void ImageLoader::jobFinished (juce::uint32 generation, Terrain::Ptr terrain)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (generation != currentGeneration)
+        return;
+
+    finishedTerrain = std::move (terrain);
+    resultPending = true;
+    triggerAsyncUpdate();
+}
+
+void ImageLoader::jobMappedTerrain (juce::uint32 generation, Terrain::Ptr builtTerrain, Terrain::Ptr mappedTerrain)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (generation != currentGeneration)
+        return;
+
+    terrainToSwapOut = std::move (builtTerrain);
+    swappedInTerrain = std::move (mappedTerrain);
+    triggerAsyncUpdate();
+}
+
+void ImageLoader::handleAsyncUpdate()
+{
+    Terrain::Ptr terrain, swapOut, swapIn;
+    bool hasResult = false, hasProgress = false, wasCancelled = false;
+    float progress = 0.0f;
+    juce::File file, fileCancelled;
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (std::exchange (cancellationPending, false))
+        {
+            wasCancelled = true;
+            fileCancelled = std::exchange (cancelledFile, juce::File());
+        }
+
+        hasProgress = std::exchange (progressPending, false);
+        progress = latestProgress;
+
+        if (std::exchange (resultPending, false))
+        {
+            hasResult = true;
+            terrain = std::move (finishedTerrain);
+            file = requestedFile;
+            loading = false;
+        }
+
+        swapOut = std::move (terrainToSwapOut);
+        swapIn = std::move (swappedInTerrain);
+    }
+
+    // Before the progress, which may already belong to a load started after the cancel.
+    if (wasCancelled)
+        listeners.call ([&fileCancelled] (Listener& l) { l.imageLoadCancelled (fileCancelled); });
+
+    if (hasProgress && ! hasResult)
+        listeners.call ([progress] (Listener& l) { l.imageLoadProgressChanged (progress); });
+
+    if (hasResult)
+        publishFinishedTerrain (terrain, file);
+
+    // Only if nothing else has been shown since
+    if (swapIn != nullptr && swapOut == publishedTerrain)
+    {
+        bitmapDataManager.publishSnapshot (swapIn->snapshot);
+        imageBuffer.setSquareImage (swapIn->image, nullptr, imageBuffer.getFile());
+        publishedTerrain = swapIn;
+    }
+}
+
+void ImageLoader::publishFinishedTerrain (Terrain::Ptr terrain, const juce::File& file)
+{
+    if (terrain != nullptr)
+    {
+        // The snapshot goes first, so that the ImageBuffer's change message finds
+        // it already published and doesn't build the pyramid a second time.
+        bitmapDataManager.publishSnapshot (terrain->snapshot);
+        imageBuffer.setSquareImage (terrain->image, terrain->highPrecisionImage, file);
+
+        releasePublishedTerrain();
+        publishedTerrain = terrain;
+        listeners.call ([] (Listener& l) { l.imageLoadProgressChanged (1.0f); });
+    }
+
+    const bool succeeded = terrain != nullptr;
+    listeners.call ([&file, succeeded] (Listener& l) { l.imageLoadFinished (file, succeeded); });
+}
+
+void ImageLoader::changeListenerCallback (juce::ChangeBroadcaster* source)
+{
+    // Someone set another image directly, so the published terrain isn't shown any more.
+    if (source == &imageBuffer && publishedTerrain != nullptr && imageBuffer.getImage() != publishedTerrain->image)
+        releasePublishedTerrain();
+}
+
+void ImageLoader::releasePublishedTerrain()
+{
+    if (publishedTerrain == nullptr)
+        return;
+
+    publishedTerrain = nullptr;
+    terrainCache->releaseUnusedTerrains();
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    ImageLoader.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ImageBuffer.h"
+#include "BitmapDataManager.h"
+#include "TerrainCache.h"
+
+/**
+    Loads images on a background thread, so that an 8k image neither freezes the
+    editor nor holds up the host while it restores a project.
+
+    Each load decodes the image, pads it to a square and builds the brightness
+    pyramid off the message thread, unless the TerrainCache already has it or
+    an .iiterrain file of it was saved by an earlier load (see TerrainFile). The
+    result is then published on the message thread in one go: the snapshot to
+    the BitmapDataManager, the image to the ImageBuffer. Starting a load cancels
+    the one in progress, so the last image asked for always wins.
+
+    The published terrain is kept until the ImageBuffer shows another image, which
+    is what tells the TerrainCache that this instance still uses it. Once a built
+    terrain has been saved, the mapped file takes its place, both in the cache and
+    here if it is still shown, so that its memory goes back.
+*/
+class ImageLoader : private juce::AsyncUpdater,
+                    private juce::ChangeListener
+{
+public:
+    ImageLoader (ImageBuffer& bufferToLoadInto, BitmapDataManager& managerToPublishTo);
+    ~ImageLoader() override;
+
+    /** Receives the progress of loads, on the message thread. */
+    struct Listener
+    {
+        virtual ~Listener() = default;
+
+        /** progress goes from 0 when a load starts to 1 when it is published. */
+        virtual void imageLoadProgressChanged (float progress) = 0;
+
+        /** Called once the image is published, or the file could not be read.
+            Loads replaced by another one don't report anything.
+        */
+        virtual void imageLoadFinished (const juce::File& file, bool succeeded) = 0;
+
+        /** Called instead of imageLoadFinished() when cancel() abandons a load.
+            file is empty for images loaded from memory.
+        */
+        virtual void imageLoadCancelled (const juce::File& file) = 0;
+    };
+
+    void addListener (Listener* listener)    { listeners.add (listener); }
+    void removeListener (Listener* listener) { listeners.remove (listener); }
+
+    /** Starts loading an image file. Can be called from any thread. */
+    void loadAsync (const juce::File& imageFile);
+
+    /** Starts loading an encoded image held in memory, e.g. a factory image. Can be called from any thread. */
+    void loadAsync (const void* encodedData, size_t dataSize);
+
+    /** Abandons the load in progress, if any; the current image stays. The
+        listeners hear of it through imageLoadCancelled().
+    */
+    void cancel();
+
+    bool isLoading() const;
+
+    /** The file being loaded if there is one, the file of the current image otherwise. */
+    juce::File getFile() const;
+
+    /** Blocks until the pending load has finished, then publishes it. For tools that
+        render straight after loading; call it from the message thread.
+        Returns false if it timed out.
+    */
+    bool waitForPendingLoads (int timeOutMilliseconds = -1);
+
+private:
+    class LoadJob;
+
+    void startJob (LoadJob* job, const juce::File& file);
+    void jobProgressChanged (juce::uint32 generation, float progress);
+    void jobFinished (juce::uint32 generation, Terrain::Ptr terrain);
+    void jobMappedTerrain (juce::uint32 generation, Terrain::Ptr builtTerrain, Terrain::Ptr mappedTerrain);
+    void handleAsyncUpdate() override;
+    void publishFinishedTerrain (Terrain::Ptr terrain, const juce::File& file);
+    void changeListenerCallback (juce::ChangeBroadcaster* source) override;
+    void releasePublishedTerrain();
+
+    ImageBuffer& imageBuffer;
+    BitmapDataManager& bitmapDataManager;
+    juce::SharedResourcePointer<TerrainCache> terrainCache;
+    std::unique_ptr<juce::ThreadPool> pool; // After the cache: its jobs use it
+
+    juce::CriticalSection lock;
+    juce::uint32 currentGeneration = 0; // Bumped by each load and cancel; older jobs are ignored.
+    bool loading = false;
+    juce::File requestedFile;
+    float latestProgress = 0.0f;
+    bool progressPending = false;
+    bool resultPending = false;
+    bool cancellationPending = false;
+    juce::File cancelledFile;
+    Terrain::Ptr finishedTerrain; // nullptr after a failed load
+    Terrain::Ptr terrainToSwapOut, swappedInTerrain; // Set once the finished terrain was saved and mapped
+    Terrain::Ptr publishedTerrain; // Message thread only
+
+    juce::ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageLoader)
+};
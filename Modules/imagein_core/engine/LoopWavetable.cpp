@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    LoopWavetable.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "LoopWavetable.h"
+
+LoopWavetable::LoopWavetable()
+{
+    spectrum.allocate ((size_t) tableSize * 2, true);
+    scratch.allocate ((size_t) tableSize * 2, true);
+    levels.allocate ((size_t) numLevels * (size_t) (tableSize + 1), true);
+}
+
+void LoopWavetable::build (const BrightnessPyramid& pyramid, const Geometry& newGeometry)
+{
+    geometry = newGeometry;
+
+    const auto& base = pyramid.getBase();
+    const float cosAngle = std::cos (geometry.angle);
+    const float sinAngle = std::sin (geometry.angle);
+
+    // Full-resolution pixels the path covers between two table entries, per unit of |d(x, y) / d theta|.
+    const float pixelsPerStep = juce::MathConstants<float>::twoPi / (float) tableSize
+                              * (float) juce::jmax (base.width - 1, base.height - 1);
+
+    // Same trajectory as EllipseReader::computeTrajectory, one point per table entry.
+    for (int i = 0; i < tableSize; ++i)
+    {
+        const float theta = juce::MathConstants<float>::twoPi * (float) i / (float) tableSize;
+        const float cosPhase = std::cos (theta);
+        const float sinPhase = std::sin (theta);
+
+        const float x = geometry.cx + (geometry.r1 * cosPhase * cosAngle - geometry.r2 * sinPhase * sinAngle);
+        const float y = geometry.cy + (geometry.r1 * cosPhase * sinAngle + geometry.r2 * sinPhase * cosAngle);
+
+        // Each entry averages the image over the stretch of path it stands for, as the
+        // reader does at the same speed: the pyramid level whose pixels are that long.
+        const float pixelsPerEntry = pixelsPerStep * std::sqrt (geometry.r1 * geometry.r1 * sinPhase * sinPhase
+                                                              + geometry.r2 * geometry.r2 * cosPhase * cosPhase);
+        const float lod = pixelsPerEntry > 1.0f ? std::log2 (pixelsPerEntry) : 0.0f;
+
+        spectrum[i] = pyramid.getTrilinear (juce::jlimit (0.0f, 1.0f, x), juce::jlimit (0.0f, 1.0f, y), lod);
+    }
+
+    fft.performRealOnlyForwardTransform (spectrum.get(), true);
+
+    for (int level = 0; level < numLevels; ++level)
+        buildLevel (level);
+
+    isValid = true;
+}
+
+const float* LoopWavetable::getTableFor (float increment) const noexcept
+{
+    // Level k holds harmonics up to tableSize / 2^(k+1), which stay below Nyquist
+    // as long as 2^k >= tableSize * increment.
+    const float harmonicsRatio = increment * (float) tableSize;
+    const int level = harmonicsRatio > 1.0f ? (int) std::ceil (std::log2 (harmonicsRatio)) : 0;
+
+    return levels.get() + (size_t) juce::jlimit (0, numLevels - 1, level) * (size_t) (tableSize + 1);
+}
+
+void LoopWavetable::buildLevel (int level)
+{
+    float* table = levels.get() + (size_t) level * (size_t) (tableSize + 1);
+
+    // Keep bins 0..maxHarmonic of the interleaved spectrum, clear the rest.
+    const int maxHarmonic = (tableSize / 2) >> level;
+    const int numKept = 2 * (maxHarmonic + 1);
+    std::copy (spectrum.get(), spectrum.get() + numKept, scratch.get());
+    std::fill (scratch.get() + numKept, scratch.get() + 2 * tableSize, 0.0f);
+
+    // The Nyquist bin of level 0 would alias against its mirror image.
+    if (level == 0)
+        scratch[tableSize] = scratch[tableSize + 1] = 0.0f;
+
+    fft.performRealOnlyInverseTransform (scratch.get());
+
+    std::copy (scratch.get(), scratch.get() + tableSize, table);
+    table[tableSize] = table[0];
+}
+
+//==============================================================================
+void SharedLoopWavetable::update (const BrightnessPyramid& pyramid, const LoopWavetable::Geometry& settledGeometry)
+{
+    if (! buildRequested.exchange (false, std::memory_order_relaxed))
+        return;
+
+    auto geometry = settledGeometry;
+    geometry.pyramidId = pyramid.getUniqueId();
+
+    if (pyramid.isValid() && ! table.holds (geometry))
+        table.build (pyramid, geometry);
+}
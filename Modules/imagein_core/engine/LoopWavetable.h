@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    LoopWavetable.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BrightnessPyramid.h"
+
+/**
+    One cycle of an ellipse scanned over the image, stored as a band-limited
+    wavetable with one mip per octave.
+
+    While a reader's geometry is static its path is a fixed closed loop, so the
+    loop is sampled once into tableSize points and played back like any other
+    wavetable. Level k keeps the first tableSize / 2^(k+1) harmonics. All levels
+    are built with the table, so reading it never writes anything and any number
+    of voices can read one table at once.
+*/
+class LoopWavetable
+{
+public:
+    static constexpr int tableOrder = 11;
+    static constexpr int tableSize = 1 << tableOrder;
+    static constexpr int numLevels = tableOrder;
+
+    /** Everything the loop depends on. Values are the clamped, smoothed parameters. */
+    struct Geometry
+    {
+        float cx = 0.0f, cy = 0.0f, r1 = 0.0f, r2 = 0.0f, angle = 0.0f;
+        juce::uint32 pyramidId = 0;
+
+        bool operator== (const Geometry& other) const noexcept
+        {
+            return cx == other.cx && cy == other.cy && r1 == other.r1 && r2 == other.r2
+                && angle == other.angle && pyramidId == other.pyramidId;
+        }
+    };
+
+    LoopWavetable();
+
+    /** Returns true if the table currently holds this geometry's loop. */
+    bool holds (const Geometry& g) const noexcept { return isValid && geometry == g; }
+
+    /** Samples the loop from the pyramid and builds every level from its spectrum.
+        Where the path covers more than a pixel per entry, entries come from the
+        coarser pyramid level that matches, so the table doesn't alias.
+        Realtime-safe: all buffers are allocated in the constructor.
+    */
+    void build (const BrightnessPyramid& pyramid, const Geometry& newGeometry);
+
+    void invalidate() noexcept { isValid = false; }
+
+    /** Returns a level with no harmonic above Nyquist when read at this increment
+        (cycles per sample). The table has tableSize + 1 points, the last one
+        repeating the first for interpolation.
+    */
+    const float* getTableFor (float increment) const noexcept;
+
+private:
+    void buildLevel (int level);
+
+    juce::dsp::FFT fft { tableOrder };
+    juce::HeapBlock<float> spectrum, scratch, levels;
+    bool isValid = false;
+    Geometry geometry;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoopWavetable)
+};
+
+//==============================================================================
+/**
+    The LoopWavetable of one synth, shared by all of its voices.
+
+    Once their smoothers have settled, unmodulated voices of a synth all follow
+    the same loop, so one table serves them all. The voices only read it, and
+    ask for it when it doesn't hold their loop; the synth then builds it once
+    before its voices render the next block, while none of them can be reading.
+    A knob tweak or a new image so costs one build per synth, whatever the
+    polyphony, and the voices scan the image in the meantime.
+*/
+class SharedLoopWavetable
+{
+public:
+    /** Voice side: the table if it holds this loop. Otherwise returns nullptr and
+        asks for it to be built before the next block.
+    */
+    const LoopWavetable* find (const LoopWavetable::Geometry& geometry) noexcept
+    {
+        if (table.holds (geometry))
+            return &table;
+
+        buildRequested.store (true, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    /** Synth side, between blocks: builds the loop of the settled geometry if a voice
+        asked for it since the last call.
+    */
+    void update (const BrightnessPyramid& pyramid, const LoopWavetable::Geometry& settledGeometry);
+
+    /** Drops the table, e.g. when the sample rate changes. Not while voices render. */
+    void invalidate() noexcept { table.invalidate(); }
+
+private:
+    LoopWavetable table;
+    std::atomic<bool> buildRequested { false };
+};
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    MapOscillator.cpp
+    Created: 12 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "MapOscillator.h"
+#include "LFO.h"
+#include "ParameterStructs.h"
+
+MapOscillator::Scratch::Scratch()
+{
+    const int maxOversampledSize = maxOversamplingChunk << maxOversamplingOrder;
+    readerBuffer.setSize (maxOversamplingChannels, maxOversampledSize);
+    oversampledBuffer.setSize (maxOversamplingChannels, maxOversampledSize);
+    oversampledModulators.setSize (ModulatorSources::NumModulators, maxOversampledSize);
+}
+
+//==============================================================================
+MapOscillator::MapOscillator()
+{
+}
+
+MapOscillator::~MapOscillator()
+{
+}
+
+void MapOscillator::prepareToPlay (double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    activeOversamplingOrder = 0;
+    for (auto* reader : readers)
+        reader->prepareToPlay (sampleRate);
+
+    decimator.reset();
+}
+
+void MapOscillator::startNote (float frequency)
+{
+    // The factor is chosen once per note, so the readers' sample rate never
+    // changes while they are sounding.
+    const bool isHighNote = frequency >= currentSampleRate * oversamplingThresholdRatio;
+    activeOversamplingOrder = isHighNote ? juce::jlimit (0, maxOversamplingOrder, requestedOversamplingOrder) : 0;
+
+    const double renderRate = currentSampleRate * (double) (1 << activeOversamplingOrder);
+
+    for (auto* reader : readers)
+    {
+        // Only the rate changes; prepareToPlay() would also clear the filter and smoothing.
+        if (reader->getSampleRate() != renderRate)
+            reader->setSampleRate (renderRate);
+
+        reader->setFrequency (frequency);
+        reader->resetPhase();
+    }
+
+    if (activeOversamplingOrder > 0)
+        decimator.reset();
+
+    lastModulatorValues.fill (0.0f);
+}
+
+void MapOscillator::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/, int startSample, int numSamples, BitmapDataManager& bitmapDataManager,
+                                  const juce::AudioBuffer<float>& modulatorBuffer, Scratch& scratch)
+{
+    if (readers.isEmpty())
+        return;
+
+    BitmapDataManager::ScopedAccess bitmapAccess (bitmapDataManager);
+    const auto* pyramid = bitmapAccess.get();
+
+    if (pyramid == nullptr || ! pyramid->isValid())
+    {
+        buffer.clear(startSample, numSamples);
+        return;
+    }
+
+    if (activeOversamplingOrder == 0 || buffer.getNumChannels() > maxOversamplingChannels)
+    {
+        renderReaders (*pyramid, buffer, startSample, numSamples, modulatorBuffer, scratch);
+        return;
+    }
+
+    for (int offset = 0; offset < numSamples; offset += maxOversamplingChunk)
+    {
+        const int chunkSize = juce::jmin (maxOversamplingChunk, numSamples - offset);
+        renderOversampled (*pyramid, buffer, startSample + offset, chunkSize, modulatorBuffer, offset, scratch);
+    }
+}
+
+void MapOscillator::renderReaders (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                                   const juce::AudioBuffer<float>& modulatorBuffer, Scratch& scratch)
+{
+    auto& readerBuffer = scratch.readerBuffer;
+    auto numChannels = buffer.getNumChannels();
+
+    if (readers.size() == 1)
+    {
+        readers[0]->processBlock (pyramid, buffer, startSample, numSamples, modulatorBuffer);
+    }
+    else
+    {
+        readerBuffer.setSize (numChannels, numSamples, false, true, true);
+        readerBuffer.clear();
+
+        // Each reader adds its output to the intermediate buffer.
+        for (auto* reader : readers)
+            reader->processBlock (pyramid, readerBuffer, 0, numSamples, modulatorBuffer);
+
+        // Finally, add the summed output to the main output buffer.
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.addFrom (channel, startSample, readerBuffer, channel, 0, numSamples);
+    }
+}
+
+void MapOscillator::renderOversampled (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                                       const juce::AudioBuffer<float>& modulatorBuffer, int modulatorOffset, Scratch& scratch)
+{
+    const int factor = 1 << activeOversamplingOrder;
+    const int numChannels = buffer.getNumChannels();
+    const int numOversampled = numSamples * factor;
+
+    // The readers are generators, so there is nothing to upsample: they render
+    // straight into the high-rate buffer, which is then decimated in place.
+    float* channels[maxOversamplingChannels] = {};
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        channels[channel] = scratch.oversampledBuffer.getWritePointer (channel);
+        juce::FloatVectorOperations::clear (channels[channel], numOversampled);
+    }
+
+    oversampledView.setDataToReferTo (channels, numChannels, numOversampled);
+
+    upsampleModulators (modulatorBuffer, modulatorOffset, numSamples, factor, scratch);
+    renderReaders (pyramid, oversampledView, 0, numOversampled, scratch.oversampledModulators, scratch);
+
+    decimator.process (channels, numChannels, numSamples, activeOversamplingOrder);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        buffer.addFrom (channel, startSample, channels[channel], numSamples);
+}
+
+void MapOscillator::upsampleModulators (const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples, int factor, Scratch& scratch)
+{
+    // Modulators stay at the host rate; each host sample becomes a linear ramp
+    // from the previous value, which delays them by one host sample.
+    const float step = 1.0f / (float) factor;
+    const int numModulators = juce::jmin (modulatorBuffer.getNumChannels(), (int) ModulatorSources::NumModulators);
+
+    for (int channel = 0; channel < numModulators; ++channel)
+    {
+        float* dest = scratch.oversampledModulators.getWritePointer (channel);
+
+        // Sources nothing listens to are silent, so skip the interpolation.
+        if ((usedModulators & (1u << channel)) == 0)
+        {
+            juce::FloatVectorOperations::clear (dest, numSamples * factor);
+            lastModulatorValues[(size_t) channel] = 0.0f;
+            continue;
+        }
+
+        const float* source = modulatorBuffer.getReadPointer (channel, startSample);
+        float previous = lastModulatorValues[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float delta = (source[i] - previous) * step;
+
+            for (int j = 1; j <= factor; ++j)
+                *dest++ = previous + delta * (float) j;
+
+            previous = source[i];
+        }
+
+        lastModulatorValues[(size_t) channel] = previous;
+    }
+}
+
+void MapOscillator::rebuildReaders (const juce::Array<ReaderBase::Type>& types)
+{
+    readers.clear();
+    activeOversamplingOrder = 0;
+
+    auto* newReader = addEllipseReader();
+    if (newReader != nullptr)
+        newReader->prepareToPlay (currentSampleRate);
+}
+
+void MapOscillator::updateParameters (const GlobalParameters& params, int readerIndex)
+{
+    requestedOversamplingOrder = params.ellipses[readerIndex].oversampling;
+    usedModulators = ModulatorSources::getUsedSources (params.ellipses[readerIndex]);
+
+    if (auto* ellipseReader = dynamic_cast<EllipseReader*> (readers[0]))
+    {
+        ellipseReader->updateParameters (params.ellipses[readerIndex]);
+        ellipseReader->setModulationInterval (params.modulationInterval);
+    }
+}
+
+EllipseReader* MapOscillator::addEllipseReader()
+{
+    // In a real application, you might want to notify listeners that a reader was added.
+    auto* newReader = new EllipseReader();
+    newReader->setLoopWavetable (loopWavetable);
+    readers.add (newReader);
+    return newReader;
+}
+
+void MapOscillator::setLoopWavetable (SharedLoopWavetable* newWavetable)
+{
+    loopWavetable = newWavetable;
+
+    for (auto* reader : readers)
+        if (auto* ellipseReader = dynamic_cast<EllipseReader*> (reader))
+            ellipseReader->setLoopWavetable (loopWavetable);
+}
+
+void MapOscillator::removeReader (int index)
+{
+    readers.remove (index);
+}
+
+int MapOscillator::getNumReaders() const { return readers.size(); }
+ReaderBase* MapOscillator::getReader (int index) { return readers[index]; }
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    MapOscillator.h
+    Created: 12 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ImageBuffer.h"
+#include "ReaderBase.h"
+#include "EllipseReader.h"
+#include "BitmapDataManager.h"
+#include "ParameterStructs.h"
+#include "HalfBandDecimator.h"
+
+struct GlobalParameters;
+class LFO;
+
+/**
+    This class manages an ImageBuffer and a collection of LineReaders to
+    generate a composite audio signal.
+*/
+class MapOscillator
+{
+public:
+    /** The buffers an oscillator renders through. They only matter during a
+        processBlock() call, so oscillators rendering on the same thread can share
+        one set. Allocated for the largest HQ factor, so switching factor at note
+        start never allocates on the audio thread.
+    */
+    struct Scratch
+    {
+        Scratch();
+
+        juce::AudioBuffer<float> readerBuffer, oversampledBuffer, oversampledModulators;
+    };
+
+    MapOscillator();
+    ~MapOscillator();
+
+    void prepareToPlay (double sampleRate);
+    void startNote (float frequency);
+    void processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, int startSample, int numSamples, BitmapDataManager& bitmapDataManager,
+                       const juce::AudioBuffer<float>& modulatorBuffer, Scratch& scratch);
+    void rebuildReaders (const juce::Array<ReaderBase::Type>& types);
+    void updateParameters (const GlobalParameters& params, int readerIndex);
+    EllipseReader* addEllipseReader();
+
+    /** Given to every ellipse reader, now and when the readers are rebuilt. */
+    void setLoopWavetable (SharedLoopWavetable* newWavetable);
+    void removeReader (int index);
+    int getNumReaders() const;
+    ReaderBase* getReader (int index);
+    const juce::OwnedArray<ReaderBase>& getReaders() const { return readers; }
+
+private:
+    void renderReaders (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                        const juce::AudioBuffer<float>& modulatorBuffer, Scratch& scratch);
+    void renderOversampled (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                            const juce::AudioBuffer<float>& modulatorBuffer, int modulatorOffset, Scratch& scratch);
+    void upsampleModulators (const juce::AudioBuffer<float>& modulatorBuffer, int startSample, int numSamples, int factor, Scratch& scratch);
+
+    juce::OwnedArray<ReaderBase> readers;
+    double currentSampleRate = 44100.0;
+    SharedLoopWavetable* loopWavetable = nullptr;
+
+    // HQ mode: the readers run at 2x, 4x or 8x the host rate and are decimated back
+    // with polyphase IIR half-band filters. The factor is fixed for the whole note,
+    // and only notes above the threshold are oversampled; lower notes are already
+    // band-limited well enough by the pyramid.
+    static constexpr int maxOversamplingOrder = HalfBandDecimator::maxOrder;
+    static constexpr int maxOversamplingChunk = 512;
+    static constexpr int maxOversamplingChannels = HalfBandDecimator::maxChannels;
+    static constexpr double oversamplingThresholdRatio = 1.0 / 100.0; // fundamental / sample rate
+
+    HalfBandDecimator decimator;
+    int requestedOversamplingOrder = 0;
+    int activeOversamplingOrder = 0;
+
+    juce::AudioBuffer<float> oversampledView;
+    std::array<float, ModulatorSources::NumModulators> lastModulatorValues {};
+    juce::uint32 usedModulators = ~0u; // ModulatorSources::getUsedSources() of the current parameters
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MapOscillator)
+};
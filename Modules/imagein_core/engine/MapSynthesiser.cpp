@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    MapSynthesiser.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "MapSynthesiser.h"
+#include "SynthVoice.h"
+
+void MapSynthesiser::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    const int numChannels = outputAudio.getNumChannels();
+
+    // Silent voices only have to clear their flag and tell the display, which
+    // isn't worth publishing a batch for.
+    voicesToRender.clearQuick();
+
+    for (auto* voice : voices)
+    {
+        auto* synthVoice = static_cast<SynthVoice*> (voice);
+
+        if (synthVoice->needsRendering())
+            voicesToRender.add (synthVoice);
+        else
+            synthVoice->renderToScratch (numChannels, numSamples);
+    }
+
+    auto renderVoice = [this, numChannels, numSamples] (int index)
+    {
+        voicesToRender.getUnchecked (index)->renderToScratch (numChannels, numSamples);
+    };
+
+    if (threadPool != nullptr)
+        threadPool->parallelFor (voicesToRender.size(), renderVoice);
+    else
+        for (int i = 0; i < voicesToRender.size(); ++i)
+            renderVoice (i);
+
+    for (auto* voice : voices)
+        static_cast<SynthVoice*> (voice)->addScratchTo (outputAudio, startSample, numSamples);
+}
+
+void MapSynthesiser::setCurrentPlaybackSampleRate (double sampleRate)
+{
+    juce::Synthesiser::setCurrentPlaybackSampleRate (sampleRate);
+    voicesToRender.ensureStorageAllocated (voices.size());
+}
+
+void MapSynthesiser::setPolyphony (int numVoices)
+{
+    numVoices = juce::jlimit (1, juce::jmax (1, voices.size()), numVoices);
+
+    if (numVoices == polyphony)
+        return;
+
+    const juce::ScopedLock sl (lock);
+    polyphony = numVoices;
+
+    for (int i = polyphony; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        if (voice->getCurrentlyPlayingNote() >= 0)
+            stopVoice (voice, 0.0f, true);
+    }
+}
+
+juce::SynthesiserVoice* MapSynthesiser::findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                       int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    const juce::ScopedLock sl (lock);
+    const int numUsableVoices = juce::jmin (polyphony, voices.size());
+
+    for (int i = 0; i < numUsableVoices; ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        if (! voice->isVoiceActive() && voice->canPlaySound (soundToPlay))
+            return voice;
+    }
+
+    if (stealIfNoneAvailable)
+        return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
+
+    return nullptr;
+}
+
+juce::SynthesiserVoice* MapSynthesiser::findVoiceToSteal (juce::SynthesiserSound* soundToPlay, int /*midiChannel*/,
+                                                          int /*midiNoteNumber*/) const
+{
+    const int numUsableVoices = juce::jmin (polyphony, voices.size());
+    SynthVoice* best = nullptr;
+
+    for (int i = 0; i < numUsableVoices; ++i)
+    {
+        auto* voice = static_cast<SynthVoice*> (voices.getUnchecked (i));
+
+        if (! voice->canPlaySound (soundToPlay))
+            continue;
+
+        if (best == nullptr)
+        {
+            best = voice;
+            continue;
+        }
+
+        // A voice whose key is up goes before one still held
+        const bool isReleased = voice->isPlayingButReleased();
+        if (isReleased != best->isPlayingButReleased())
+        {
+            if (isReleased)
+                best = voice;
+            continue;
+        }
+
+        // Then the quietest, then the oldest
+        const float levelDifference = voice->getEnvelopeLevel() - best->getEnvelopeLevel();
+        if (levelDifference < -0.001f
+             || (levelDifference <= 0.001f && voice->wasStartedBefore (*best)))
+            best = voice;
+    }
+
+    return best;
+}
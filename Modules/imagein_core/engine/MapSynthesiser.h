@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    MapSynthesiser.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RenderThreadPool.h"
+
+class SynthVoice;
+
+/**
+    The Synthesiser driving one ellipse's SynthVoices.
+
+    All voices are allocated up front; setPolyphony() only changes how many of
+    them can be given new notes, so it never allocates.
+
+    Every voice renders into its own buffer first, and the buffers are then
+    added to the output in voice order. With a thread pool set, the first step
+    runs in parallel for the voices that have something to play; the sum is the
+    same either way.
+*/
+class MapSynthesiser : public juce::Synthesiser
+{
+public:
+    /** The pool voices are rendered on, or nullptr to render them on the calling thread. */
+    void setThreadPool (RenderThreadPool* newPool) noexcept { threadPool = newPool; }
+
+    /** Sets how many of the preallocated voices new notes may use. Voices above
+        the limit are released and play out their tail.
+    */
+    void setPolyphony (int numVoices);
+    int getPolyphony() const noexcept { return polyphony; }
+
+    /** Also sizes the list of voices to render, so renderVoices() never allocates. */
+    void setCurrentPlaybackSampleRate (double sampleRate) override;
+
+protected:
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+    juce::SynthesiserVoice* findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                           int midiNoteNumber, bool stealIfNoneAvailable) const override;
+
+    /** Prefers a released voice, then the quietest one, then the oldest. */
+    juce::SynthesiserVoice* findVoiceToSteal (juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                              int midiNoteNumber) const override;
+
+private:
+    RenderThreadPool* threadPool = nullptr;
+    int polyphony = 1;
+    juce::Array<SynthVoice*> voicesToRender; // Playing, or with a declick tail left
+};
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    MidiRouter.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "MidiRouter.h"
+
+void MidiRouter::prepare (int maxBytesPerBlock)
+{
+    for (auto& buffer : filtered)
+    {
+        buffer.clear();
+        buffer.ensureSize ((size_t) maxBytesPerBlock);
+    }
+}
+
+void MidiRouter::route (const juce::MidiBuffer& input, const std::array<int, numSynths>& channels)
+{
+    bool anyFiltered = false;
+
+    for (size_t i = 0; i < (size_t) numSynths; ++i)
+    {
+        filtered[i].clear(); // keeps its storage
+
+        const bool isOmni = channels[i] == 0;
+        routed[i] = isOmni ? &input : &filtered[i];
+        anyFiltered = anyFiltered || ! isOmni;
+    }
+
+    if (! anyFiltered)
+        return;
+
+    for (const auto metadata : input)
+    {
+        // Same as MidiMessage::getChannel(), without building a message: channel
+        // messages carry it in the status byte, system messages have none.
+        const auto status = metadata.numBytes > 0 ? metadata.data[0] : (juce::uint8) 0;
+        const int channel = (status & 0xf0) != 0xf0 && (status & 0x80) != 0 ? (status & 0x0f) + 1 : 0;
+
+        for (size_t i = 0; i < (size_t) numSynths; ++i)
+            if (channels[i] != 0 && channels[i] == channel)
+                filtered[i].addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+    }
+}
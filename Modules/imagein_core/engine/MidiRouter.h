@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    MidiRouter.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Splits the host's MIDI between the three synths by channel.
+
+    Omni synths read the host buffer as it is. The others get their own buffer,
+    filled in a single pass over the host events. Those buffers keep their
+    storage from block to block and are reserved in prepare(), so routing does
+    not allocate unless a block carries more MIDI than was reserved.
+*/
+class MidiRouter
+{
+public:
+    static constexpr int numSynths = 3;
+
+    MidiRouter() = default;
+
+    /** Reserves room for about maxBytesPerBlock of MIDI data per synth. */
+    void prepare (int maxBytesPerBlock);
+
+    /** Routes a block. A channel of 0 means omni. */
+    void route (const juce::MidiBuffer& input, const std::array<int, numSynths>& channels);
+
+    /** The events for a synth from the last route() call. */
+    const juce::MidiBuffer& getEventsFor (int synthIndex) const noexcept { return *routed[(size_t) synthIndex]; }
+
+private:
+    std::array<juce::MidiBuffer, numSynths> filtered;
+    std::array<const juce::MidiBuffer*, numSynths> routed { &filtered[0], &filtered[1], &filtered[2] };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiRouter)
+};
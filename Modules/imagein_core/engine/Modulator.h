@@ -14,8 +14,6 @@
 
 #pragma once
 
-#include <JuceHeader.h>
-
 class Modulator
 {
 public:
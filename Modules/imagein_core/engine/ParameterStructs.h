@@ -14,8 +14,6 @@
 
 #pragma once
 
-#include <JuceHeader.h>
-
 enum class FilterType
 {
     Lowpass,
@@ -27,6 +25,35 @@ static const juce::StringArray tempoSyncRateChoices {
     "1/32", "1/16T", "1/16", "1/16D", "1/8T", "1/8", "1/8D", "1/4T", "1/4", "1/4D", "1/2T", "1/2", "1/2D", "1 Bar"
 };
 
+// LFO cycles per quarter note for each of the tempoSyncRateChoices
+inline float getTempoSyncRateMultiplier (int choice)
+{
+    switch (choice)
+    {
+        case 0:  return 8.0f;        // 1/32
+        case 1:  return 4.0f * 1.5f; // 1/16T
+        case 2:  return 4.0f;        // 1/16
+        case 3:  return 4.0f / 1.5f; // 1/16D
+        case 4:  return 2.0f * 1.5f; // 1/8T
+        case 5:  return 2.0f;        // 1/8
+        case 6:  return 2.0f / 1.5f; // 1/8D
+        case 7:  return 1.0f * 1.5f; // 1/4T
+        case 8:  return 1.0f;        // 1/4
+        case 9:  return 1.0f / 1.5f; // 1/4D
+        case 10: return 0.5f * 1.5f; // 1/2T
+        case 11: return 0.5f;        // 1/2
+        case 12: return 0.5f / 1.5f; // 1/2D
+        case 13: return 0.25f;       // 1 Bar
+        default: return 1.0f;
+    }
+}
+
+static const juce::StringArray oversamplingChoices { "Off", "2x", "4x", "8x" };
+
+// How often geometry modulation is evaluated, interpolated linearly in between.
+static const juce::StringArray modulationRateChoices { "Audio rate", "Every 16", "Every 32" };
+static const int modulationIntervals[] { 1, 16, 32 };
+
 static const juce::StringArray lfoWaveformChoices {
     "Sine", "SQ", "TRI", "SAW+", "SAW-"
 };
@@ -107,6 +134,7 @@ struct EllipseReaderParameters
     float volume = 1.0f;
     float detune = 0.0f;
     float pan = 0.0f;
+    int oversampling = 0; // index into oversamplingChoices, i.e. log2 of the factor
 
     float modCxAmount = 0.0f;
     int   modCxSelect = 0;
@@ -128,6 +156,33 @@ struct EllipseReaderParameters
     FilterParameters filter;
 };
 
+namespace ModulatorSources
+{
+    /** Bitmask of the sources an ellipse actually listens to: those selected by a
+        route with a non-zero amount. */
+    inline juce::uint32 getUsedSources (const EllipseReaderParameters& p)
+    {
+        juce::uint32 mask = 0;
+        auto use = [&mask] (float amount, int select)
+        {
+            if (amount != 0.0f && juce::isPositiveAndBelow (select, (int) NumModulators))
+                mask |= 1u << select;
+        };
+
+        use (p.modCxAmount, p.modCxSelect);
+        use (p.modCyAmount, p.modCySelect);
+        use (p.modR1Amount, p.modR1Select);
+        use (p.modR2Amount, p.modR2Select);
+        use (p.modAngleAmount, p.modAngleSelect);
+        use (p.modVolumeAmount, p.modVolumeSelect);
+        use (p.modPanAmount, p.modPanSelect);
+        use (p.modFreqAmount, p.modFreqSelect);
+        use (p.filter.modFreqAmount, p.filter.modFreqSelect);
+        use (p.filter.modQualityAmount, p.filter.modQualitySelect);
+        return mask;
+    }
+}
+
 struct ADSRParameters
 {
     float attack = 0.1f;
@@ -139,6 +194,8 @@ struct ADSRParameters
 struct GlobalParameters
 {
     std::array<EllipseReaderParameters, 3> ellipses;
+    int modulationInterval = 1; // in samples
+    int polyphony = 4; // voices per synth
     ADSRParameters adsr;
     ADSRParameters adsr2;
     ADSRParameters adsr3;
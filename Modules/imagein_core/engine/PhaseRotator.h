@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    PhaseRotator.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Recursive quadrature oscillator giving cos/sin of a reader's phase for its
+    three octave taps (half, base and double increment).
+
+    Each tap is a unit complex number multiplied every sample by a fixed rotation.
+    The rotations are only rebuilt when the increment changes: one sincos for the
+    octave below, then squared for the base and squared again for the octave above.
+    Rounding slowly pulls the taps off the unit circle, so call renormalise() every
+    few dozen samples.
+*/
+class PhaseRotator
+{
+public:
+    static constexpr int numTaps = 3; // octave below, base, octave above
+
+    PhaseRotator() { reset(); }
+
+    /** Puts every tap back at phase 0. */
+    void reset() noexcept
+    {
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            re[tap] = 1.0f;
+            im[tap] = 0.0f;
+        }
+    }
+
+    /** Sets the base increment, in cycles per sample. Cheap when it has not changed. */
+    void setIncrement (float cyclesPerSample) noexcept
+    {
+        if (cyclesPerSample == increment)
+            return;
+
+        increment = cyclesPerSample;
+
+        const double halfAngle = (double) cyclesPerSample * juce::MathConstants<double>::pi;
+        double c = std::cos (halfAngle);
+        double s = std::sin (halfAngle);
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            stepRe[tap] = (float) c;
+            stepIm[tap] = (float) s;
+
+            const double nextC = c * c - s * s;
+            s = 2.0 * c * s;
+            c = nextC;
+        }
+    }
+
+    float getCos (int tap) const noexcept { return re[tap]; }
+    float getSin (int tap) const noexcept { return im[tap]; }
+
+    /** Returns a tap's phase in cycles, within [0, 1). */
+    float getPhase (int tap) const noexcept
+    {
+        const float cycles = std::atan2 (im[tap], re[tap]) / juce::MathConstants<float>::twoPi;
+        return cycles < 0.0f ? cycles + 1.0f : cycles;
+    }
+
+    /** Moves a tap to a phase given in cycles. */
+    void setPhase (int tap, float cycles) noexcept
+    {
+        const float angle = cycles * juce::MathConstants<float>::twoPi;
+        re[tap] = std::cos (angle);
+        im[tap] = std::sin (angle);
+    }
+
+    /** Moves every tap forward by one sample. */
+    void advance() noexcept
+    {
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            const float nextRe = re[tap] * stepRe[tap] - im[tap] * stepIm[tap];
+            im[tap] = re[tap] * stepIm[tap] + im[tap] * stepRe[tap];
+            re[tap] = nextRe;
+        }
+    }
+
+    /** Pulls the taps back onto the unit circle (one Newton step on 1/|z|). */
+    void renormalise() noexcept
+    {
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            const float gain = 1.5f - 0.5f * (re[tap] * re[tap] + im[tap] * im[tap]);
+            re[tap] *= gain;
+            im[tap] *= gain;
+        }
+    }
+
+private:
+    float re[numTaps], im[numTaps];
+    float stepRe[numTaps] = {}, stepIm[numTaps] = {};
+    float increment = -1.0f;
+
+    JUCE_LEAK_DETECTOR (PhaseRotator)
+};
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    ReaderBase.cpp
+    Created: 13 Sep 2025 11:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "ReaderBase.h"
+#include "LFO.h"
+#include "FastMath.h"
+
+void ReaderBase::prepareToPlay(double sr)
+{
+    sampleRate = sr;
+    filter.prepare (sampleRate);
+    filterBypassed = false;
+    panSmoother.reset(sr, 0.05);
+}
+
+void ReaderBase::setSampleRate (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    filter.setSampleRate (sampleRate);
+    rescaleSmoother (panSmoother, sampleRate, 0.05);
+}
+
+void ReaderBase::rescaleSmoother (juce::LinearSmoothedValue<float>& smoother, double newSampleRate, double rampTimeSeconds)
+{
+    // reset() jumps to the target, so the ramp is started again from where it was.
+    const float current = smoother.getCurrentValue();
+    const float target = smoother.getTargetValue();
+    smoother.reset (newSampleRate, rampTimeSeconds);
+    smoother.setCurrentAndTargetValue (current);
+    smoother.setTargetValue (target);
+}
+
+void ReaderBase::setFrequency (float freq)
+{
+    frequency = freq;
+}
+
+float ReaderBase::getFrequency() const
+{
+    return frequency;
+}
+
+void ReaderBase::setVolume (float newVolume)
+{
+    volume = juce::jlimit (0.0f, 1.0f, newVolume);
+    volumeSmoother.setTargetValue (volume);
+}
+
+float ReaderBase::getVolume() const
+{
+    return volume;
+}
+
+void ReaderBase::setPan (float newPan)
+{
+    pan = juce::jlimit (-1.0f, 1.0f, newPan);
+    panSmoother.setTargetValue (pan);
+}
+
+void ReaderBase::updateFilterParameters(const FilterParameters& params)
+{
+    filterType = params.type;
+    filterFreq = params.frequency;
+    filterQuality = params.quality;
+    modFilterFreqAmount = params.modFreqAmount;
+    modFilterFreqSelect = params.modFreqSelect;
+    modFilterQualityAmount = params.modQualityAmount;
+    modFilterQualitySelect = params.modQualitySelect;
+}
+
+void ReaderBase::resetPhase()
+{
+    phaseRotator.reset();
+}
+
+void ReaderBase::applyFilter (float* samples, const float* modFreqSignal, const float* modQualitySignal, int numSamples)
+{
+    const auto type = (FilterType) filterType.load();
+    const auto mode = type == FilterType::Highpass ? StateVariableFilter::Mode::highpass
+                                                   : StateVariableFilter::Mode::lowpass;
+
+    const float baseFreq = filterFreq.load();
+    const float baseQ = filterQuality.load();
+    const float freqModAmount = modFilterFreqAmount.load();
+    const float qualityModAmount = modFilterQualityAmount.load();
+
+    if (freqModAmount == 0.0f && qualityModAmount == 0.0f)
+    {
+        // A fully open lowpass without resonance does next to nothing: skip it.
+        if (type == FilterType::Lowpass && baseFreq >= 20000.0f && baseQ <= 1.0f)
+        {
+            if (! filterBypassed)
+            {
+                filter.reset();
+                filterBypassed = true;
+            }
+            return;
+        }
+
+        // Knob moves are ramped over the block, otherwise the coefficients stay as they are.
+        filterBypassed = false;
+        filter.setTarget (mode, juce::jlimit (20.0f, 20000.0f, baseFreq), juce::jlimit (0.1f, 18.0f, baseQ), numSamples);
+        filter.process (samples, numSamples);
+        return;
+    }
+
+    // Modulated: evaluate the modulation at the end of each short segment and
+    // ramp the coefficients towards it.
+    filterBypassed = false;
+    const float numOctaves = 7.0f; // Modulate over a +/- 7 octave range
+
+    for (int start = 0; start < numSamples; start += filterControlInterval)
+    {
+        const int segmentLength = juce::jmin (filterControlInterval, numSamples - start);
+        const int last = start + segmentLength - 1;
+
+        // Frequency modulation (exponential)
+        const float bipolarFreqMod = modFreqSignal[last] * 2.0f - 1.0f;
+        const float modulatedFreq = baseFreq * FastMath::exp2 (freqModAmount * bipolarFreqMod * numOctaves);
+
+        // Quality modulation (linear bipolar)
+        const float bipolarQualityMod = modQualitySignal[last] * 2.0f - 1.0f;
+        const float modulatedQ = baseQ * (1.0f + qualityModAmount * bipolarQualityMod);
+
+        filter.setTarget (mode, juce::jlimit (20.0f, 20000.0f, modulatedFreq), juce::jlimit (0.1f, 18.0f, modulatedQ), segmentLength);
+        filter.process (samples + start, segmentLength);
+    }
+}
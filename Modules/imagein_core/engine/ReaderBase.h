@@ -14,8 +14,10 @@
 
 #pragma once
 
-#include <JuceHeader.h>
 #include "ParameterStructs.h"
+#include "BrightnessPyramid.h"
+#include "PhaseRotator.h"
+#include "StateVariableFilter.h"
 
 class LFO;
 
@@ -40,15 +42,22 @@ public:
     virtual ~ReaderBase() = default;
 
     virtual void prepareToPlay (double sampleRate);
-    virtual void processBlock (const juce::Image::BitmapData& bitmapData, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const juce::AudioBuffer<float>& modulatorBuffer) = 0;
+
+    /** Moves the reader to another rate, e.g. when a note starts in HQ mode, without
+        resetting it: the filter keeps its state and the smoothed values their
+        current position. Realtime-safe.
+    */
+    virtual void setSampleRate (double newSampleRate);
+    virtual void processBlock (const BrightnessPyramid& pyramid, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const juce::AudioBuffer<float>& modulatorBuffer) = 0;
 
     void setFrequency (float freq);
     float getFrequency() const;
+    double getSampleRate() const { return sampleRate; }
     void setVolume (float newVolume);
     float getVolume() const;
     void setPan (float newPan);
     void updateFilterParameters(const FilterParameters& params);
-    void resetPhase();
+    virtual void resetPhase();
 
     virtual Type getType() const = 0;
 
@@ -57,17 +66,24 @@ public:
 protected:
     float frequency = 440.0f;
     double sampleRate = 44100.0;
-    float phase = 0.0f;
-    float phaseLow = 0.0f;
-    float phaseHigh = 0.0f;
+    PhaseRotator phaseRotator;
     float volume = 1.0f;
     juce::LinearSmoothedValue<float> volumeSmoother;
     std::atomic<float> pan { 0.0f };
     juce::LinearSmoothedValue<float> panSmoother;
 
-    float applyFilter(float inputSample, float modFreqSignal, float modQualitySignal);
+    /** Filters a block in place. The coefficients only move when the knobs or the
+        modulation do, and a fully open lowpass is bypassed.
+    */
+    void applyFilter (float* samples, const float* modFreqSignal, const float* modQualitySignal, int numSamples);
+
+    /** Sets a smoother's ramp for a new rate, carrying on from its current value. */
+    static void rescaleSmoother (juce::LinearSmoothedValue<float>& smoother, double newSampleRate, double rampTimeSeconds);
+
+    static constexpr int filterControlInterval = 16; // samples between modulated coefficient updates
 
-    juce::dsp::StateVariableTPTFilter<float> filter;
+    StateVariableFilter filter;
+    bool filterBypassed = false;
 
     std::atomic<int> filterType { (int)FilterType::Lowpass };
     std::atomic<float> filterFreq { 20000.0f };
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    RenderThreadPool.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "RenderThreadPool.h"
+
+namespace
+{
+    // Set by each worker as it starts.
+    thread_local const RenderThreadPool* currentWorkerPool = nullptr;
+    thread_local int currentWorkerIndex = -1;
+}
+
+RenderThreadPool::RenderThreadPool (int numWorkers)
+{
+    jassert (numWorkers <= maxWorkers);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto* worker = workers.add (new Worker (*this, i));
+        worker->startRealtimeThread (juce::Thread::RealtimeOptions {}.withPriority (10));
+    }
+}
+
+RenderThreadPool::~RenderThreadPool()
+{
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    for (auto* worker : workers)
+        worker->stopThread (1000);
+}
+
+int RenderThreadPool::getCurrentThreadIndex() const noexcept
+{
+    return currentWorkerPool == this ? currentWorkerIndex + 1 : 0;
+}
+
+void RenderThreadPool::run (Batch& batch)
+{
+    if (batch.numJobs <= 0)
+        return;
+
+    Slot* slot = nullptr;
+
+    if (batch.numJobs > 1 && ! workers.isEmpty())
+    {
+        for (auto& candidate : slots)
+        {
+            Batch* expected = nullptr;
+            if (candidate.batch.compare_exchange_strong (expected, &batch))
+            {
+                slot = &candidate;
+                break;
+            }
+        }
+    }
+
+    // Single jobs, no workers, or every slot taken: just do the work here.
+    if (slot == nullptr)
+    {
+        for (int i = 0; i < batch.numJobs; ++i)
+            batch.invoke (batch.context, i);
+        return;
+    }
+
+    wakeWorkers();
+    runJobs (batch);
+
+    while (batch.jobsDone.load (std::memory_order_acquire) < batch.numJobs)
+        std::this_thread::yield();
+
+    slot->batch.store (nullptr);
+
+    while (slot->visitors.load() != 0)
+        std::this_thread::yield();
+}
+
+bool RenderThreadPool::runJobs (Batch& batch)
+{
+    bool didWork = false;
+
+    for (;;)
+    {
+        const int index = batch.nextJob.fetch_add (1, std::memory_order_relaxed);
+        if (index >= batch.numJobs)
+            return didWork;
+
+        batch.invoke (batch.context, index);
+        batch.jobsDone.fetch_add (1, std::memory_order_release);
+        didWork = true;
+    }
+}
+
+bool RenderThreadPool::runAnyPublishedJobs()
+{
+    bool didWork = false;
+
+    for (auto& slot : slots)
+    {
+        slot.visitors.fetch_add (1);
+
+        if (auto* batch = slot.batch.load())
+            didWork = runJobs (*batch) || didWork;
+
+        slot.visitors.fetch_sub (1);
+    }
+
+    return didWork;
+}
+
+void RenderThreadPool::wakeWorkers()
+{
+    // Pairs with the re-check a worker does after counting itself as sleeping,
+    // so a batch published while it is dozing off is never missed.
+    if (numSleepingWorkers.load() == 0)
+        return;
+
+    for (auto* worker : workers)
+        worker->notify();
+}
+
+//==============================================================================
+RenderThreadPool::Worker::Worker (RenderThreadPool& owner, int workerIndex)
+    : juce::Thread ("Image-In render " + juce::String (workerIndex)),
+      pool (owner),
+      index (workerIndex)
+{
+}
+
+void RenderThreadPool::Worker::run()
+{
+    currentWorkerPool = &pool;
+    currentWorkerIndex = index;
+
+    double lastWorkMs = juce::Time::getMillisecondCounterHiRes();
+
+    while (! threadShouldExit())
+    {
+        // Nested batches can be published while we work, so look again after each pass.
+        if (pool.runAnyPublishedJobs())
+        {
+            lastWorkMs = juce::Time::getMillisecondCounterHiRes();
+            continue;
+        }
+
+        // Between blocks, stay ready for the next batch rather than park.
+        if (pool.keepWorkersAwake.load (std::memory_order_relaxed)
+             && juce::Time::getMillisecondCounterHiRes() - lastWorkMs < maxSpinMs)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        pool.numSleepingWorkers.fetch_add (1);
+
+        if (! pool.runAnyPublishedJobs())
+            wait (100);
+
+        pool.numSleepingWorkers.fetch_sub (1);
+        lastWorkMs = juce::Time::getMillisecondCounterHiRes();
+    }
+}
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    RenderThreadPool.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    A fixed set of realtime-priority worker threads for splitting a block's
+    rendering across cores.
+
+    parallelFor() publishes a batch of jobs and returns once all of them have
+    run. Workers and the calling thread take jobs by atomically bumping the
+    batch's next-job index, so no lock is taken and idle threads pick up
+    whatever is left. The caller works on its own batch too, which makes nested
+    calls (voices inside a synth that is itself a job) safe.
+
+    parallelFor() never allocates. While the pool is kept awake, workers that
+    find no job yield for up to maxSpinMs before they sleep, so the next block
+    finds them ready instead of paying for a wake-up. Otherwise they go back to
+    sleep at once and an idle pool costs no CPU; publishing a batch wakes them.
+*/
+class RenderThreadPool
+{
+public:
+    static constexpr int maxWorkers = 15;
+
+    explicit RenderThreadPool (int numWorkers);
+    ~RenderThreadPool();
+
+    int getNumWorkers() const noexcept { return workers.size(); }
+
+    /** Lets idle workers spin between batches, which is worth it while blocks keep
+        coming, or makes them sleep as soon as they run out of jobs.
+    */
+    void setKeepWorkersAwake (bool shouldKeepAwake) noexcept { keepWorkersAwake = shouldKeepAwake; }
+
+    /** 1 + the index of this pool's worker that is calling, or 0 from any other
+        thread. Lets jobs pick per-thread scratch memory without a lock.
+    */
+    int getCurrentThreadIndex() const noexcept;
+
+    /** Calls function (i) for every i in [0, numJobs) and waits for all of them. */
+    template <typename Function>
+    void parallelFor (int numJobs, Function&& function)
+    {
+        using FunctionType = std::remove_reference_t<Function>;
+
+        Batch batch;
+        batch.context = (void*) std::addressof (function);
+        batch.invoke = [] (void* context, int index) { (*static_cast<FunctionType*> (context)) (index); };
+        batch.numJobs = numJobs;
+        run (batch);
+    }
+
+private:
+    struct Batch
+    {
+        void (*invoke) (void*, int) = nullptr;
+        void* context = nullptr;
+        int numJobs = 0;
+        std::atomic<int> nextJob { 0 };
+        std::atomic<int> jobsDone { 0 };
+    };
+
+    // A published batch. Visitors are threads that may still touch the batch,
+    // so its owner waits for them to leave before the batch goes out of scope.
+    struct Slot
+    {
+        std::atomic<Batch*> batch { nullptr };
+        std::atomic<int> visitors { 0 };
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker (RenderThreadPool& owner, int workerIndex);
+        void run() override;
+
+    private:
+        RenderThreadPool& pool;
+        const int index;
+    };
+
+    static constexpr int maxActiveBatches = 16;
+
+    // Longer than any block period, so workers only sleep once the host stops calling.
+    static constexpr double maxSpinMs = 50.0;
+
+    void run (Batch& batch);
+    static bool runJobs (Batch& batch);
+    bool runAnyPublishedJobs();
+    void wakeWorkers();
+
+    Slot slots[maxActiveBatches];
+    std::atomic<int> numSleepingWorkers { 0 };
+    std::atomic<bool> keepWorkersAwake { false };
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderThreadPool)
+};
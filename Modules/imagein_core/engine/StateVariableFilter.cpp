@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    StateVariableFilter.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "StateVariableFilter.h"
+
+void StateVariableFilter::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    targetCutoff = targetResonance = -1.0f; // force the next setTarget to recompute
+    rampSamplesRemaining = 0;
+    reset();
+}
+
+void StateVariableFilter::reset() noexcept
+{
+    s1 = s2 = 0.0f;
+}
+
+void StateVariableFilter::setSampleRate (double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    targetCutoff = targetResonance = -1.0f;
+    rampSamplesRemaining = 0;
+}
+
+void StateVariableFilter::setTarget (Mode newMode, float cutoffHz, float resonance, int rampLength) noexcept
+{
+    mode = newMode;
+
+    if (cutoffHz == targetCutoff && resonance == targetResonance)
+        return;
+
+    const bool isFirstSetting = targetCutoff < 0.0f;
+    targetCutoff = cutoffHz;
+    targetResonance = resonance;
+
+    // Keep the cutoff safely below Nyquist, as tan() blows up there.
+    const double maxCutoff = sampleRate * 0.49;
+    const double cutoff = juce::jlimit (1.0, maxCutoff, (double) cutoffHz);
+    const float newG = (float) std::tan (juce::MathConstants<double>::pi * cutoff / sampleRate);
+    const float newR2 = 1.0f / resonance;
+
+    if (isFirstSetting || rampLength <= 0)
+    {
+        g = newG;
+        R2 = newR2;
+        h = 1.0f / (1.0f + R2 * g + g * g);
+        rampSamplesRemaining = 0;
+        return;
+    }
+
+    gStep = (newG - g) / (float) rampLength;
+    R2Step = (newR2 - R2) / (float) rampLength;
+    rampSamplesRemaining = rampLength;
+}
+
+void StateVariableFilter::process (float* samples, int numSamples) noexcept
+{
+    const bool isHighpass = mode == Mode::highpass;
+    int i = 0;
+
+    // While ramping, g and R2 move every sample and h follows them exactly.
+    for (; i < numSamples && rampSamplesRemaining > 0; ++i, --rampSamplesRemaining)
+    {
+        g += gStep;
+        R2 += R2Step;
+        h = 1.0f / (1.0f + R2 * g + g * g);
+
+        const float yHP = h * (samples[i] - s1 * (g + R2) - s2);
+        const float yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+        const float yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        samples[i] = isHighpass ? yHP : yLP;
+    }
+
+    const float gR2 = g + R2;
+
+    for (; i < numSamples; ++i)
+    {
+        const float yHP = h * (samples[i] - s1 * gR2 - s2);
+        const float yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+        const float yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        samples[i] = isHighpass ? yHP : yLP;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    StateVariableFilter.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Mono topology-preserving-transform state variable filter, with the same
+    response as juce::dsp::StateVariableTPTFilter.
+
+    The difference is when the coefficients are computed: setTarget() only calls
+    tan() when the cutoff, resonance or sample rate actually changed, and can ramp
+    the coefficients linearly to their new values over a number of samples. process()
+    is then a tight loop over a block.
+*/
+class StateVariableFilter
+{
+public:
+    enum class Mode { lowpass, highpass };
+
+    void prepare (double newSampleRate);
+    void reset() noexcept;
+
+    /** Changes the sample rate without clearing the filter's state. The next
+        setTarget() recomputes the coefficients for it.
+    */
+    void setSampleRate (double newSampleRate) noexcept;
+
+    /** Moves towards a new setting. With rampLength > 0 the coefficients are
+        interpolated over that many samples, otherwise they change at once.
+        Cheap when nothing changed.
+    */
+    void setTarget (Mode newMode, float cutoffHz, float resonance, int rampLength) noexcept;
+
+    /** Filters the samples in place. */
+    void process (float* samples, int numSamples) noexcept;
+
+private:
+    double sampleRate = 44100.0;
+    Mode mode = Mode::lowpass;
+
+    float targetCutoff = -1.0f, targetResonance = -1.0f;
+    float g = 0.0f, R2 = 0.0f, h = 0.0f;
+    float gStep = 0.0f, R2Step = 0.0f;
+    int rampSamplesRemaining = 0;
+    float s1 = 0.0f, s2 = 0.0f;
+
+    JUCE_LEAK_DETECTOR (StateVariableFilter)
+};
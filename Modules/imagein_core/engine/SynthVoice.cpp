@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+    SynthVoice.cpp
+    Created: 16 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "SynthVoice.h"
+#include "ImageInEngine.h"
+#include "ParameterStructs.h"
+
+SynthVoice::SynthVoice(ImageInEngine& e, int vIndex, int rIndex)
+    : engine(e),
+      readerIndex(rIndex),
+      voiceIndex(vIndex)
+{
+    mapOscillator.setLoopWavetable (&engine.getLoopWavetable (readerIndex));
+}
+
+void SynthVoice::RenderScratch::prepare (int maximumBlockSize, double sampleRate)
+{
+    modulators.setSize (ModulatorSources::NumModulators + 1, juce::jmax (maximumBlockSize, getDeclickLength (sampleRate)));
+}
+
+void SynthVoice::prepare (int maximumBlockSize, int numChannels)
+{
+    tempRenderBuffer.setSize (numChannels, maximumBlockSize);
+}
+
+bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound)
+{
+    return dynamic_cast<SynthSound*> (sound) != nullptr;
+}
+
+void SynthVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition)
+{
+    const double frequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    mapOscillator.startNote ((float) frequency); // Sets the readers' frequency and phase, and picks the oversampling factor
+    noteVel = velocity;
+
+    adsr.noteOn();
+    adsr2.noteOn();
+    adsr3.noteOn();
+}
+
+void SynthVoice::stopNote (float velocity, bool allowTailOff)
+{
+    // A hard stop (voice stolen, or all notes off) hands the sound being cut off
+    // to a short fade-out and restarts the envelopes from zero.
+    if (! allowTailOff && isVoiceActive())
+    {
+        renderDeclickTail();
+        adsr.reset();
+        adsr2.reset();
+        adsr3.reset();
+    }
+
+    adsr.noteOff();
+    adsr2.noteOff();
+    adsr3.noteOff();
+
+    if (! allowTailOff || ! isVoiceActive())
+        clearCurrentNote();
+}
+
+bool SynthVoice::isVoiceActive() const
+{
+    return adsr.isActive() || adsr2.isActive() || adsr3.isActive();
+}
+
+void SynthVoice::setCurrentPlaybackSampleRate (double newRate)
+{
+    juce::SynthesiserVoice::setCurrentPlaybackSampleRate (newRate);
+    declickLength = getDeclickLength (getSampleRate());
+    declickBuffer.setSize (2, declickLength);
+    declickSamplesRemaining = 0;
+    mapOscillator.prepareToPlay (getSampleRate());
+    adsr.prepareToPlay (getSampleRate());
+    adsr2.prepareToPlay (getSampleRate());
+    adsr3.prepareToPlay (getSampleRate());
+}
+
+void SynthVoice::resetADSRs()
+{
+    adsr.reset();
+    adsr2.reset();
+    adsr3.reset();
+    declickSamplesRemaining = 0;
+    clearCurrentNote();
+}
+
+void SynthVoice::rebuildReaders (const juce::Array<ReaderBase::Type>& types)
+{
+    mapOscillator.rebuildReaders (types);
+}
+
+void SynthVoice::renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    renderToScratch (outputBuffer.getNumChannels(), numSamples);
+    addScratchTo (outputBuffer, startSample, numSamples);
+}
+
+void SynthVoice::renderToScratch (int numChannels, int numSamples)
+{
+    hasScratchAudio = false;
+    tempRenderBuffer.setSize (numChannels, numSamples, false, false, true);
+
+    if (isVoiceActive())
+    {
+        renderVoice (tempRenderBuffer, numSamples);
+        hasScratchAudio = true;
+
+        // Report state to GUI
+        {
+            VoiceDisplayState displayState;
+            displayState.isActive = true;
+
+            const auto& readers = mapOscillator.getReaders();
+            displayState.numReaders = juce::jmin (readers.size(), VoiceDisplayState::maxReaders);
+            for (int i = 0; i < displayState.numReaders; ++i)
+                displayState.readerInfos[i] = readers.getUnchecked(i)->lastDrawingInfo;
+
+            engine.voiceDisplayStates[readerIndex][voiceIndex].write (displayState);
+            displayStateIsActive = true;
+        }
+
+        if (! isVoiceActive())
+        {
+            clearCurrentNote();
+            // Final update to ensure GUI shows inactive state
+            publishInactiveDisplayState();
+        }
+    }
+    else
+    {
+        // Ensure the GUI knows this voice is off
+        publishInactiveDisplayState();
+    }
+
+    if (declickSamplesRemaining > 0)
+    {
+        if (! hasScratchAudio)
+            tempRenderBuffer.clear();
+
+        const int numTailSamples = juce::jmin (numSamples, declickSamplesRemaining);
+        const int numTailChannels = juce::jmin (numChannels, declickBuffer.getNumChannels());
+
+        for (int ch = 0; ch < numTailChannels; ++ch)
+            tempRenderBuffer.addFrom (ch, 0, declickBuffer, ch, declickLength - declickSamplesRemaining, numTailSamples);
+
+        declickSamplesRemaining -= numTailSamples;
+        hasScratchAudio = true;
+    }
+}
+
+void SynthVoice::renderVoice (juce::AudioBuffer<float>& destination, int numSamples)
+{
+    // Update parameters from the engine's pre-filled struct
+    adsr.setParameters (engine.globalParams.adsr);
+    adsr2.setParameters (engine.globalParams.adsr2);
+    adsr3.setParameters (engine.globalParams.adsr3);
+    mapOscillator.updateParameters (engine.globalParams, readerIndex);
+
+    // Build only the modulator channels the ellipse listens to. The others point
+    // at a shared silent channel, and LFOs are read straight from the engine
+    // unless a declick tail outlasts its block.
+    using namespace ModulatorSources;
+    const auto usedSources = getUsedSources (engine.globalParams.ellipses[readerIndex]);
+    auto isUsed = [usedSources] (int source) { return (usedSources & (1u << source)) != 0; };
+
+    // Sized in prepare, so this only allocates if the host exceeds its maximum block size.
+    auto& scratch = engine.getRenderScratch();
+    auto& ownedModulators = scratch.modulators;
+    ownedModulators.setSize (NumModulators + 1, numSamples, false, false, true);
+    ownedModulators.clear (zeroChannel, 0, numSamples);
+    float* silent = ownedModulators.getWritePointer (zeroChannel);
+
+    const int numLfoSamples = juce::jmin (numSamples, engine.lfoBuffer.getNumSamples());
+    ADSR* adsrs[] = { &adsr, &adsr2, &adsr3 };
+
+    for (int lfoIndex = 0; lfoIndex < 4; ++lfoIndex)
+    {
+        const int source = LFO1 + lfoIndex;
+        bool needed = isUsed (source);
+        for (int adsrIndex = 0; adsrIndex < 3; ++adsrIndex)
+            needed = needed || isUsed (LFO1_ADSR1 + lfoIndex * 3 + adsrIndex);
+
+        if (! needed)
+            modulatorChannels[source] = silent;
+        else if (numLfoSamples == numSamples)
+            modulatorChannels[source] = const_cast<float*> (engine.lfoBuffer.getReadPointer (lfoIndex));
+        else
+        {
+            auto* lfoWriter = ownedModulators.getWritePointer (source);
+            ownedModulators.copyFrom (source, 0, engine.lfoBuffer, lfoIndex, 0, numLfoSamples);
+            juce::FloatVectorOperations::fill (lfoWriter + numLfoSamples, numLfoSamples > 0 ? lfoWriter[numLfoSamples - 1] : 0.0f, numSamples - numLfoSamples);
+            modulatorChannels[source] = lfoWriter;
+        }
+    }
+
+    // Every envelope runs, as they decide when the voice ends, but only the
+    // ones listened to are written out.
+    for (int adsrIndex = 0; adsrIndex < 3; ++adsrIndex)
+    {
+        const int source = ADSR1 + adsrIndex;
+        bool needed = isUsed (source);
+        for (int lfoIndex = 0; lfoIndex < 4; ++lfoIndex)
+            needed = needed || isUsed (LFO1_ADSR1 + lfoIndex * 3 + adsrIndex);
+
+        if (! needed)
+        {
+            adsrs[adsrIndex]->advance (numSamples);
+            modulatorChannels[source] = silent;
+            continue;
+        }
+
+        auto* adsrWriter = ownedModulators.getWritePointer (source);
+        for (int i = 0; i < numSamples; ++i)
+            adsrWriter[i] = adsrs[adsrIndex]->process();
+
+        modulatorChannels[source] = adsrWriter;
+    }
+
+    // Combined LFO*ADSR channels
+    for (int lfoIndex = 0; lfoIndex < 4; ++lfoIndex)
+    {
+        for (int adsrIndex = 0; adsrIndex < 3; ++adsrIndex)
+        {
+            const int source = LFO1_ADSR1 + lfoIndex * 3 + adsrIndex;
+
+            if (! isUsed (source))
+            {
+                modulatorChannels[source] = silent;
+                continue;
+            }
+
+            auto* productWriter = ownedModulators.getWritePointer (source);
+            juce::FloatVectorOperations::multiply (productWriter, modulatorChannels[LFO1 + lfoIndex], modulatorChannels[ADSR1 + adsrIndex], numSamples);
+            modulatorChannels[source] = productWriter;
+        }
+    }
+
+    modulatorBuffer.setDataToReferTo (modulatorChannels, NumModulators, numSamples);
+
+    // Render audio
+    destination.clear (0, numSamples);
+
+    juce::MidiBuffer emptyMidi;
+    mapOscillator.processBlock (destination, emptyMidi, 0, numSamples, engine.bitmapDataManager, modulatorBuffer, scratch.oscillator);
+
+    destination.applyGain (0, numSamples, noteVel);
+}
+
+void SynthVoice::renderDeclickTail()
+{
+    renderVoice (declickBuffer, declickLength);
+    declickBuffer.applyGainRamp (0, declickLength, 1.0f, 0.0f);
+    declickSamplesRemaining = declickLength;
+}
+
+void SynthVoice::publishInactiveDisplayState()
+{
+    if (! displayStateIsActive)
+        return;
+
+    engine.voiceDisplayStates[readerIndex][voiceIndex].write (VoiceDisplayState {});
+    displayStateIsActive = false;
+}
+
+void SynthVoice::addScratchTo (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) const
+{
+    if (! hasScratchAudio)
+        return;
+
+    for (int ch = 0; ch < outputBuffer.getNumChannels(); ++ch)
+        outputBuffer.addFrom (ch, startSample, tempRenderBuffer, ch, 0, numSamples);
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    SynthVoice.h
+    Created: 16 Sep 2025 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SynthSound.h"
+#include "MapOscillator.h"
+#include "ADSR.h"
+
+class ImageInEngine;
+
+class SynthVoice : public juce::SynthesiserVoice
+{
+public:
+    /** Buffers a voice only uses while it renders. The voices rendering on one
+        thread share a set, so there are as many as render threads, not voices.
+    */
+    struct RenderScratch
+    {
+        /** Sizes the modulator channels for blocks of up to maximumBlockSize samples,
+            and for the declick tails of voices running at sampleRate.
+        */
+        void prepare (int maximumBlockSize, double sampleRate);
+
+        juce::AudioBuffer<float> modulators; // the channels a voice computes itself, plus one silent channel
+        MapOscillator::Scratch oscillator;
+    };
+
+    SynthVoice (ImageInEngine& e, int voiceIndex, int readerIndex);
+
+    /** Allocates the voice's output buffer for blocks of up to maximumBlockSize samples. */
+    void prepare (int maximumBlockSize, int numChannels);
+    
+    bool canPlaySound (juce::SynthesiserSound* sound) override;
+    
+    void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition) override;
+    
+    void stopNote (float velocity, bool allowTailOff) override;
+    
+    bool isVoiceActive() const override;
+
+    /** True if renderToScratch() has audio to produce: a note, or a declick tail. */
+    bool needsRendering() const noexcept { return isVoiceActive() || declickSamplesRemaining > 0; }
+
+    void pitchWheelMoved (int newPitchWheelValue) override {}
+    
+    void controllerMoved (int controllerNumber, int newControllerValue) override {}
+    
+    void setCurrentPlaybackSampleRate (double newRate) override;
+
+    void renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
+
+    /** Renders the next block into the voice's own buffer. Only touches this
+        voice's state, so different voices can render on different threads.
+    */
+    void renderToScratch (int numChannels, int numSamples);
+
+    /** Adds what renderToScratch() produced, if anything, to the output. */
+    void addScratchTo (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) const;
+
+    void rebuildReaders (const juce::Array<ReaderBase::Type>& types);
+
+    /** Silences the voice at once, including any declick tail, and frees it. */
+    void resetADSRs();
+
+    /** The samples a declick tail lasts at this rate. */
+    static int getDeclickLength (double sampleRate) noexcept { return juce::jmax (1, juce::roundToInt (sampleRate * declickSeconds)); }
+
+    /** Level of the volume envelope, used to pick a voice to steal. */
+    float getEnvelopeLevel() const { return adsr.getLatestValue(); }
+
+    /** Tells the map display this voice is silent, if it has not been told already. */
+    void publishInactiveDisplayState();
+
+    int getReaderIndex() const { return readerIndex; }
+
+private:
+    void renderVoice (juce::AudioBuffer<float>& destination, int numSamples);
+    void renderDeclickTail();
+
+    static constexpr double declickSeconds = 0.003;
+
+    ImageInEngine& engine;
+    MapOscillator mapOscillator;
+    ADSR adsr; // Main ADSR for volume
+    ADSR adsr2; // Modulation ADSR
+    ADSR adsr3; // Modulation ADSR
+    juce::AudioBuffer<float> tempRenderBuffer;
+    bool hasScratchAudio = false;
+    bool displayStateIsActive = false; // last value written to the engine's display state
+    int readerIndex;
+    int voiceIndex;
+    float noteVel{0.f};
+
+    // modulatorBuffer refers to the channels of RenderScratch::modulators, or to the engine's LFOs.
+    static constexpr int zeroChannel = ModulatorSources::NumModulators;
+    float* modulatorChannels[ModulatorSources::NumModulators] = {};
+    juce::AudioBuffer<float> modulatorBuffer;
+
+    // The few ms of a note cut off by a steal, faded out and mixed over the next blocks
+    juce::AudioBuffer<float> declickBuffer;
+    int declickLength = 1;
+    int declickSamplesRemaining = 0;
+};
\ No newline at end of file
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    TerrainCache.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "TerrainCache.h"
+
+Terrain::Terrain (const juce::Image& squareImage, HighPrecisionImage::Ptr squareHighPrecisionImage,
+                  const BrightnessPyramid::ProgressCallback& progressCallback)
+    : image (squareImage),
+      highPrecisionImage (std::move (squareHighPrecisionImage)),
+      snapshot (new BitmapDataManager::Snapshot (image, highPrecisionImage.get(), progressCallback))
+{
+    const auto pixels = (size_t) image.getWidth() * (size_t) image.getHeight();
+    sizeInBytes = pixels * 4 + snapshot->pyramid.getSizeInBytes();
+
+    if (highPrecisionImage != nullptr)
+        sizeInBytes += pixels * sizeof (float);
+}
+
+Terrain::Terrain (const juce::Image& previewImage, std::unique_ptr<TerrainFile> terrainFile)
+    : image (previewImage),
+      snapshot (new BitmapDataManager::Snapshot (image, std::move (terrainFile)))
+{
+    sizeInBytes = (size_t) image.getWidth() * (size_t) image.getHeight() * 4;
+}
+
+//==============================================================================
+TerrainCache::Key TerrainCache::makeKey (const void* encodedData, size_t dataSize, juce::uint32 preparationSettings)
+{
+    constexpr juce::uint64 prime = 0x100000001b3ull;
+    juce::uint64 hash = 0xcbf29ce484222325ull;
+
+    auto addByte = [&hash] (juce::uint8 byte)
+    {
+        hash ^= byte;
+        hash *= prime;
+    };
+
+    for (int i = 0; i < 4; ++i)
+        addByte ((juce::uint8) (preparationSettings >> (8 * i)));
+
+    const auto* bytes = static_cast<const juce::uint8*> (encodedData);
+
+    for (size_t i = 0; i < dataSize; ++i)
+        addByte (bytes[i]);
+
+    return { hash, dataSize };
+}
+
+Terrain::Ptr TerrainCache::getOrCreate (const Key& key,
+                                        const std::function<Terrain::Ptr()>& create,
+                                        const std::function<bool()>& shouldAbort)
+{
+    juce::ReferenceCountedObjectPtr<Build> build;
+
+    for (;;)
+    {
+        juce::ReferenceCountedObjectPtr<Build> otherBuild;
+
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (auto terrain = find (key))
+                return terrain;
+
+            for (auto* b : builds)
+                if (b->key == key)
+                    otherBuild = b;
+
+            if (otherBuild == nullptr)
+            {
+                build = new Build();
+                build->key = key;
+                builds.add (build);
+                break;
+            }
+        }
+
+        // Someone else is building it. If they give up, the next pass builds it here instead.
+        while (! otherBuild->finished.wait (10))
+            if (shouldAbort())
+                return nullptr;
+    }
+
+    // Built outside the lock, which other keys don't wait for.
+    auto terrain = create();
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (terrain != nullptr)
+        {
+            entries.push_back ({ { key }, terrain, ++useCounter });
+            evictUnusedTerrains();
+        }
+
+        builds.removeObject (build);
+    }
+
+    build->finished.signal();
+    return terrain;
+}
+
+void TerrainCache::replace (const Terrain& oldTerrain, Terrain::Ptr newTerrain, const Key& extraKey)
+{
+    const juce::ScopedLock sl (lock);
+
+    // Whatever extraKey named before is out of date.
+    for (auto& entry : entries)
+        entry.keys.erase (std::remove (entry.keys.begin(), entry.keys.end(), extraKey), entry.keys.end());
+
+    entries.erase (std::remove_if (entries.begin(), entries.end(), [] (const Entry& entry) { return entry.keys.empty(); }),
+                   entries.end());
+
+    // The old terrain's entry takes the extra key, so the new one still has a single entry.
+    auto existing = std::find_if (entries.begin(), entries.end(), [&oldTerrain] (const Entry& entry) { return entry.terrain.get() == &oldTerrain; });
+
+    if (existing != entries.end())
+    {
+        existing->terrain = std::move (newTerrain);
+        existing->keys.push_back (extraKey);
+        existing->lastUsed = ++useCounter;
+    }
+    else
+    {
+        entries.push_back ({ { extraKey }, std::move (newTerrain), ++useCounter });
+    }
+
+    evictUnusedTerrains();
+}
+
+Terrain::Ptr TerrainCache::find (const Key& key)
+{
+    for (auto& entry : entries)
+    {
+        if (std::find (entry.keys.begin(), entry.keys.end(), key) != entry.keys.end())
+        {
+            entry.lastUsed = ++useCounter;
+            return entry.terrain;
+        }
+    }
+
+    return nullptr;
+}
+
+void TerrainCache::evictUnusedTerrains()
+{
+    // A terrain only the cache refers to is unused: dropping it frees memory.
+    // Dropping one still in use would only stop the next instance from sharing it.
+    auto isUnused = [] (const Entry& entry) { return entry.terrain->getReferenceCount() == 1; };
+
+   #if JUCE_DEBUG
+    // That only holds while each terrain has one entry, however many keys lead to it.
+    for (const auto& entry : entries)
+        jassert (std::count_if (entries.begin(), entries.end(), [&entry] (const Entry& other) { return other.terrain == entry.terrain; }) == 1);
+   #endif
+
+    for (;;)
+    {
+        size_t unusedBytes = 0;
+        Entry* oldest = nullptr;
+
+        for (auto& entry : entries)
+        {
+            if (! isUnused (entry))
+                continue;
+
+            unusedBytes += entry.terrain->getSizeInBytes();
+
+            if (oldest == nullptr || entry.lastUsed < oldest->lastUsed)
+                oldest = &entry;
+        }
+
+        if (oldest == nullptr || unusedBytes <= byteBudget)
+            return;
+
+        entries.erase (entries.begin() + (oldest - entries.data()));
+    }
+}
+
+void TerrainCache::setByteBudget (size_t newBudget)
+{
+    const juce::ScopedLock sl (lock);
+    byteBudget = newBudget;
+    evictUnusedTerrains();
+}
+
+size_t TerrainCache::getByteBudget() const
+{
+    const juce::ScopedLock sl (lock);
+    return byteBudget;
+}
+
+void TerrainCache::releaseUnusedTerrains()
+{
+    const juce::ScopedLock sl (lock);
+    evictUnusedTerrains();
+}
+
+size_t TerrainCache::getTotalBytes() const
+{
+    const juce::ScopedLock sl (lock);
+    size_t total = 0;
+
+    for (const auto& entry : entries)
+        total += entry.terrain->getSizeInBytes();
+
+    return total;
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    TerrainCache.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "HighPrecisionImage.h"
+#include "BitmapDataManager.h"
+
+/**
+    Everything an image becomes once it has been loaded: the square image shown
+    on screen, its full-precision version if it has one, and the snapshot with
+    the brightness pyramid the readers sample. Never modified once built, so
+    every plugin instance that loads the same image can share one.
+*/
+struct Terrain : public juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<Terrain>;
+
+    /** Builds the brightness pyramid. Both images must already be square. If the
+        progress callback abandons the build, the snapshot's pyramid is invalid.
+    */
+    Terrain (const juce::Image& squareImage, HighPrecisionImage::Ptr squareHighPrecisionImage,
+             const BrightnessPyramid::ProgressCallback& progressCallback = {});
+
+    /** Reads from a mapped .iiterrain file, with its preview as the image. */
+    Terrain (const juce::Image& previewImage, std::unique_ptr<TerrainFile> terrainFile);
+
+    /** The memory it holds. Mapped pages belong to the OS, so they don't count. */
+    size_t getSizeInBytes() const noexcept { return sizeInBytes; }
+
+    const juce::Image image;
+    const HighPrecisionImage::Ptr highPrecisionImage;
+    const BitmapDataManager::Snapshot::Ptr snapshot;
+
+private:
+    size_t sizeInBytes = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Terrain)
+};
+
+/**
+    A process-wide cache of Terrains, so that the instances of a session that
+    use the same image decode it once and share its memory.
+
+    Terrains are keyed by a hash of the encoded image and of the settings used to
+    prepare it, so a renamed file or a factory image picked again is found too.
+    When several threads ask for the same terrain at once, one builds it and the
+    others wait for it. A terrain is in use while an ImageLoader has it published.
+    Terrains no instance uses any more are kept while the cache is under its byte
+    budget, and dropped least recently used first.
+
+    Get it through a juce::SharedResourcePointer<TerrainCache>.
+*/
+class TerrainCache
+{
+public:
+    TerrainCache() = default;
+
+    struct Key
+    {
+        juce::uint64 hash = 0;
+        size_t size = 0;
+
+        bool operator== (const Key& other) const noexcept { return hash == other.hash && size == other.size; }
+    };
+
+    /** Hashes encoded image data (FNV-1a) along with the settings that affect how it is prepared. */
+    static Key makeKey (const void* encodedData, size_t dataSize, juce::uint32 preparationSettings);
+
+    /** Returns the cached terrain for key, or calls create to build it and caches the result.
+        create may return nullptr, for an unreadable image or a cancelled load; nothing is
+        cached then. While another thread is building the same terrain, this waits for it,
+        checking shouldAbort every few milliseconds.
+    */
+    Terrain::Ptr getOrCreate (const Key& key,
+                              const std::function<Terrain::Ptr()>& create,
+                              const std::function<bool()>& shouldAbort);
+
+    /** Puts newTerrain in place of oldTerrain wherever the cache holds it, and under
+        extraKey too. For a built terrain once it has been saved and mapped: the instances
+        that find it from then on share the mapped one instead of keeping both.
+    */
+    void replace (const Terrain& oldTerrain, Terrain::Ptr newTerrain, const Key& extraKey);
+
+    /** The budget for terrains no instance is using. Terrains in use don't count against it. */
+    void setByteBudget (size_t newBudget);
+    size_t getByteBudget() const;
+
+    /** The memory held by every cached terrain, whether used or not. */
+    size_t getTotalBytes() const;
+
+    /** Drops unused terrains until the cache is back under its budget. Call it after
+        releasing a terrain, so that its memory goes back as soon as nobody uses it.
+    */
+    void releaseUnusedTerrains();
+
+private:
+    // One per terrain, with every key that leads to it, so that a terrain only
+    // its entry refers to is unused.
+    struct Entry
+    {
+        std::vector<Key> keys;
+        Terrain::Ptr terrain;
+        juce::uint64 lastUsed = 0;
+    };
+
+    // A terrain being built, which other threads asking for it wait on.
+    struct Build : public juce::ReferenceCountedObject
+    {
+        Key key;
+        juce::WaitableEvent finished { true };
+    };
+
+    Terrain::Ptr find (const Key& key);
+    void evictUnusedTerrains();
+
+    mutable juce::CriticalSection lock;
+    std::vector<Entry> entries;
+    juce::ReferenceCountedArray<Build> builds;
+    juce::uint64 useCounter = 0;
+    size_t byteBudget = 512 * 1024 * 1024;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TerrainCache)
+};
@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+    TerrainFile.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "TerrainFile.h"
+#include "BrightnessPyramid.h"
+
+namespace
+{
+    const char terrainMagic[8] = { 'I', 'I', 'T', 'E', 'R', 'R', 'N', 0 };
+    constexpr juce::uint32 terrainVersion = 1;
+    constexpr size_t headerSize = 64;
+    constexpr size_t levelEntrySize = 24;
+    constexpr juce::uint64 levelAlignment = 4096; // One page, so that a level never shares one with another
+
+    juce::uint64 alignUp (juce::uint64 value, juce::uint64 alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    juce::uint64 hashString (const juce::String& text)
+    {
+        // FNV-1a, as for the TerrainCache keys.
+        juce::uint64 hash = 0xcbf29ce484222325ull;
+
+        for (auto* p = text.toRawUTF8(); *p != 0; ++p)
+        {
+            hash ^= (juce::uint8) *p;
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    bool writeZeros (juce::OutputStream& out, juce::uint64 numBytes)
+    {
+        return numBytes == 0 || out.writeRepeatedByte (0, (size_t) numBytes);
+    }
+}
+
+TerrainFile::TerrainFile (std::unique_ptr<juce::MemoryMappedFile> file)
+    : mappedFile (std::move (file))
+{
+}
+
+TerrainFile::~TerrainFile()
+{
+}
+
+juce::uint64 TerrainFile::getSourceIdentity (const juce::File& source)
+{
+    return hashString (source.getFullPathName()
+                        + "|" + juce::String (source.getSize())
+                        + "|" + juce::String (source.getLastModificationTime().toMilliseconds()));
+}
+
+juce::File TerrainFile::getCacheFileFor (juce::uint64 sourceIdentity)
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+               .getChildFile ("Image-In")
+               .getChildFile ("TerrainCache")
+               .getChildFile (juce::String::toHexString ((juce::int64) sourceIdentity) + ".iiterrain");
+}
+
+bool TerrainFile::write (const juce::File& destination, const BrightnessPyramid& pyramid,
+                         const juce::Image& previewImage, const Metadata& metadata,
+                         const std::function<bool()>& shouldAbort)
+{
+   #if JUCE_BIG_ENDIAN
+    // The samples are written as they are in memory, and read back in place.
+    juce::ignoreUnused (destination, pyramid, previewImage, metadata, shouldAbort);
+    return false;
+   #else
+    if (! pyramid.isValid()
+         || pyramid.getBase().width > maxDimension || pyramid.getBase().height > maxDimension
+         || ! destination.getParentDirectory().createDirectory())
+        return false;
+
+    juce::MemoryOutputStream preview;
+    juce::PNGImageFormat().writeImageToStream (previewImage, preview);
+
+    // Work out where everything goes
+    const int numLevels = pyramid.getNumLevels();
+    std::vector<juce::uint64> offsets;
+    auto position = alignUp (headerSize + levelEntrySize * (size_t) numLevels, levelAlignment);
+
+    for (int i = 0; i < numLevels; ++i)
+    {
+        const auto& level = pyramid.getLevel (i);
+        offsets.push_back (position);
+        position = alignUp (position + (juce::uint64) level.getSizeInBytes(), levelAlignment);
+    }
+
+    const auto previewOffset = position;
+
+    // Written next to the destination, then moved over it, so that a half-written
+    // file is never mistaken for a terrain.
+    juce::TemporaryFile temporary (destination);
+
+    {
+        juce::FileOutputStream out (temporary.getFile());
+
+        if (out.failedToOpen())
+            return false;
+
+        out.write (terrainMagic, sizeof (terrainMagic));
+        out.writeInt ((int) terrainVersion);
+        out.writeInt ((int) SampleFormat::float32);
+        out.writeInt ((int) metadata.paddingMode);
+        out.writeInt (numLevels);
+        out.writeInt (metadata.originalWidth);
+        out.writeInt (metadata.originalHeight);
+        out.writeInt64 ((juce::int64) metadata.sourceIdentity);
+        out.writeInt64 ((juce::int64) previewOffset);
+        out.writeInt64 ((juce::int64) preview.getDataSize());
+        writeZeros (out, headerSize - (juce::uint64) out.getPosition());
+
+        for (int i = 0; i < numLevels; ++i)
+        {
+            const auto& level = pyramid.getLevel (i);
+            out.writeInt (level.width);
+            out.writeInt (level.height);
+            out.writeInt (level.lineStride);
+            out.writeInt ((int) level.layout);
+            out.writeInt64 ((juce::int64) offsets[(size_t) i]);
+        }
+
+        for (int i = 0; i < numLevels; ++i)
+        {
+            const auto& level = pyramid.getLevel (i);
+            writeZeros (out, offsets[(size_t) i] - (juce::uint64) out.getPosition());
+
+            // A few megabytes at a time, so that a cancelled load doesn't wait for the whole level.
+            constexpr size_t chunkSize = 4 << 20;
+            const auto* samples = reinterpret_cast<const char*> (level.data);
+            const auto levelSize = level.getSizeInBytes();
+
+            for (size_t written = 0; written < levelSize; written += chunkSize)
+            {
+                if (shouldAbort())
+                    return false;
+
+                if (! out.write (samples + written, juce::jmin (chunkSize, levelSize - written)))
+                    return false;
+            }
+        }
+
+        writeZeros (out, previewOffset - (juce::uint64) out.getPosition());
+        out.write (preview.getData(), preview.getDataSize());
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temporary.overwriteTargetFileWithTemporary();
+   #endif
+}
+
+std::unique_ptr<TerrainFile> TerrainFile::open (const juce::File& file, juce::uint64 expectedSourceIdentity)
+{
+   #if JUCE_BIG_ENDIAN
+    juce::ignoreUnused (file, expectedSourceIdentity);
+    return nullptr;
+   #else
+    auto mapped = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*> (mapped->getData());
+    const auto size = (juce::uint64) mapped->getSize();
+
+    if (data == nullptr || size < headerSize || std::memcmp (data, terrainMagic, sizeof (terrainMagic)) != 0)
+        return nullptr;
+
+    auto readInt = [data] (size_t offset) { return juce::ByteOrder::littleEndianInt (data + offset); };
+    auto readInt64 = [data] (size_t offset) { return juce::ByteOrder::littleEndianInt64 (data + offset); };
+
+    const auto version = readInt (8);
+    const auto sampleFormat = readInt (12);
+    const auto paddingMode = readInt (16);
+    const auto numLevels = readInt (20);
+
+    if (version != terrainVersion
+         || sampleFormat != (juce::uint32) SampleFormat::float32
+         || paddingMode != (juce::uint32) PaddingMode::mirror
+         || numLevels == 0 || numLevels > 32
+         || size < headerSize + levelEntrySize * numLevels
+         || readInt64 (32) != expectedSourceIdentity)
+        return nullptr;
+
+    std::unique_ptr<TerrainFile> terrain (new TerrainFile (std::move (mapped)));
+    terrain->metadata.paddingMode = PaddingMode::mirror;
+    terrain->metadata.originalWidth = (int) readInt (24);
+    terrain->metadata.originalHeight = (int) readInt (28);
+    terrain->metadata.sourceIdentity = expectedSourceIdentity;
+    terrain->previewOffset = readInt64 (40);
+    terrain->previewSize = readInt64 (48);
+
+    if (terrain->previewOffset > size || terrain->previewSize > size - terrain->previewOffset)
+        return nullptr;
+
+    for (juce::uint32 i = 0; i < numLevels; ++i)
+    {
+        const auto entry = headerSize + levelEntrySize * i;
+
+        Level level;
+        level.width = (int) readInt (entry);
+        level.height = (int) readInt (entry + 4);
+        level.lineStride = (int) readInt (entry + 8);
+        const auto layout = readInt (entry + 12);
+        level.offset = readInt64 (entry + 16);
+
+        if (layout > (juce::uint32) BrightnessPlane::Layout::tiled)
+            return nullptr;
+
+        level.layout = (BrightnessPlane::Layout) layout;
+
+        // Never trust a file enough to read outside of it. The sizes are bounded
+        // before anything is computed from them.
+        if (level.width <= 1 || level.height <= 1
+             || level.width > maxDimension || level.height > maxDimension
+             || (i > 0 && (level.width != (terrain->levels.back().width + 1) / 2
+                            || level.height != (terrain->levels.back().height + 1) / 2))
+             || (level.layout == BrightnessPlane::Layout::rowMajor && level.lineStride < level.width)
+             || level.offset % BrightnessPlane::alignmentBytes != 0
+             || level.offset > size
+             || BrightnessPlane::getNumFloats (level.layout, level.width, level.height, level.lineStride) * sizeof (float) > size - level.offset)
+            return nullptr;
+
+        terrain->levels.push_back (level);
+    }
+
+    return terrain;
+   #endif
+}
+
+void TerrainFile::pruneCacheFolder (juce::int64 maxBytes)
+{
+    auto files = getCacheFileFor (0).getParentDirectory().findChildFiles (juce::File::findFiles, false, "*.iiterrain");
+
+    std::sort (files.begin(), files.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() > b.getLastModificationTime();
+    });
+
+    juce::int64 total = 0;
+
+    for (const auto& file : files)
+    {
+        total += file.getSize();
+
+        // May fail while another instance has it mapped; it goes next time.
+        if (total > maxBytes)
+            file.deleteFile();
+    }
+}
+
+BrightnessPlane TerrainFile::createLevelView (int index) const
+{
+    const auto& level = levels[(size_t) index];
+    const auto* samples = reinterpret_cast<const float*> (static_cast<const char*> (mappedFile->getData()) + level.offset);
+    return BrightnessPlane (samples, level.width, level.height, level.lineStride, level.layout);
+}
+
+juce::Image TerrainFile::loadPreview() const
+{
+    const auto* data = static_cast<const char*> (mappedFile->getData());
+    return juce::ImageFileFormat::loadFrom (data + previewOffset, (size_t) previewSize);
+}
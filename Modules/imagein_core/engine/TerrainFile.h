@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    TerrainFile.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BrightnessPlane.h"
+
+class BrightnessPyramid;
+
+/**
+    An .iiterrain file: a brightness pyramid saved exactly as the readers sample
+    it, so that it can be memory-mapped instead of decoded.
+
+    Large images are saved in a cache folder the first time they are loaded.
+    Later loads map the file: the readers sample straight from the mapped pages,
+    and the OS only reads in the parts of the image the ellipses sweep.
+
+    Layout, little-endian:
+      - a 64-byte header: magic "IITERRN", version, sample format, padding mode,
+        number of levels, original size, source identity, preview position
+      - a table with the size, line stride, layout and offset of each level
+      - the levels, each starting on a page boundary, as float32 samples in
+        [-1, 1] laid out exactly as in a BrightnessPlane
+      - an 8-bit PNG preview of the image, for the display
+*/
+class TerrainFile
+{
+public:
+    ~TerrainFile();
+
+    enum class SampleFormat : juce::uint32 { float32 = 0 };
+
+    /** How the image was made square. */
+    enum class PaddingMode : juce::uint32 { mirror = 0 };
+
+    struct Metadata
+    {
+        int originalWidth = 0, originalHeight = 0; // Before padding, i.e. the image's own aspect
+        PaddingMode paddingMode = PaddingMode::mirror;
+        juce::uint64 sourceIdentity = 0;
+    };
+
+    /** Images whose square is smaller than this decode fast enough not to need a file. */
+    static constexpr int minimumSizeToSave = 4096;
+
+    /** The largest side a file may have, which is as large as JUCE decodes. Larger
+        pyramids aren't saved, and files that claim one are rejected.
+    */
+    static constexpr int maxDimension = 65536;
+
+    /** Identifies a source file by path, size and modification time, without reading it. */
+    static juce::uint64 getSourceIdentity (const juce::File& source);
+
+    /** Where the terrain of a source is saved. */
+    static juce::File getCacheFileFor (juce::uint64 sourceIdentity);
+
+    /** Writes a pyramid, its preview and metadata. Gives up, deleting what it wrote,
+        as soon as shouldAbort returns true.
+    */
+    static bool write (const juce::File& destination, const BrightnessPyramid& pyramid,
+                       const juce::Image& previewImage, const Metadata& metadata,
+                       const std::function<bool()>& shouldAbort);
+
+    /** Maps a file, or returns nullptr if it isn't a valid terrain of that source. Each
+        level must be the previous one halved, rounding up, as BrightnessPyramid builds it.
+    */
+    static std::unique_ptr<TerrainFile> open (const juce::File& file, juce::uint64 expectedSourceIdentity);
+
+    /** Deletes the least recently used files of the cache folder until it holds at most maxBytes. */
+    static void pruneCacheFolder (juce::int64 maxBytes);
+
+    const Metadata& getMetadata() const noexcept { return metadata; }
+
+    int getNumLevels() const noexcept { return (int) levels.size(); }
+
+    /** A plane that reads from the mapped file. It must not outlive this object. */
+    BrightnessPlane createLevelView (int index) const;
+
+    /** Decodes the preview stored in the file. */
+    juce::Image loadPreview() const;
+
+private:
+    struct Level
+    {
+        int width = 0, height = 0, lineStride = 0;
+        BrightnessPlane::Layout layout = BrightnessPlane::Layout::rowMajor;
+        juce::uint64 offset = 0;
+    };
+
+    TerrainFile (std::unique_ptr<juce::MemoryMappedFile> mappedFile);
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    Metadata metadata;
+    std::vector<Level> levels;
+    juce::uint64 previewOffset = 0, previewSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TerrainFile)
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+    Wait-free hand-over of a small value from one writer thread to one reader.
+
+    Three copies are kept: the writer fills its own, then swaps it with the
+    shared middle one; the reader swaps the middle one with its own when a newer
+    value is waiting. Neither side ever blocks or allocates, and the reader
+    always gets the most recent complete value.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+    static_assert (std::is_trivially_copyable<T>::value, "TripleBuffer copies values with plain assignment");
+
+    /** Writer side: publishes a new value. */
+    void write (const T& value) noexcept
+    {
+        buffers[backIndex] = value;
+        const auto previous = middle.exchange ((juce::uint8) (backIndex | freshBit), std::memory_order_acq_rel);
+        backIndex = (juce::uint8) (previous & indexMask);
+    }
+
+    /** Reader side: returns the latest value written, or the previous one if nothing new came in. */
+    const T& read() noexcept
+    {
+        if ((middle.load (std::memory_order_relaxed) & freshBit) != 0)
+        {
+            const auto previous = middle.exchange (frontIndex, std::memory_order_acq_rel);
+            frontIndex = (juce::uint8) (previous & indexMask);
+        }
+
+        return buffers[frontIndex];
+    }
+
+private:
+    static constexpr juce::uint8 indexMask = 3;
+    static constexpr juce::uint8 freshBit = 4;
+
+    T buffers[3] {};
+    std::atomic<juce::uint8> middle { 1 };
+    juce::uint8 backIndex = 0;  // owned by the writer
+    juce::uint8 frontIndex = 2; // owned by the reader
+};
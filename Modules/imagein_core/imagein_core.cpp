@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    imagein_core.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#ifdef IMAGEIN_CORE_H_INCLUDED
+ /* When you add this cpp file to your project, you mustn't include it in a file where you've
+    already included any other headers - just put it inside a file on its own, possibly with your config
+    flags preceding it, but don't include anything else. That also includes avoiding any automatic prefix
+    header files that the compiler may be using.
+ */
+ #error "Incorrect use of JUCE cpp file"
+#endif
+
+#include "imagein_core.h"
+
+#include "engine/HighPrecisionImage.cpp"
+#include "engine/BrightnessPlane.cpp"
+#include "engine/TerrainFile.cpp"
+#include "engine/BrightnessPyramid.cpp"
+#include "engine/LoopWavetable.cpp"
+#include "engine/StateVariableFilter.cpp"
+#include "engine/HalfBandDecimator.cpp"
+#include "engine/ADSR.cpp"
+#include "engine/ImageBuffer.cpp"
+#include "engine/BitmapDataManager.cpp"
+#include "engine/TerrainCache.cpp"
+#include "engine/ImageLoader.cpp"
+#include "engine/ReaderBase.cpp"
+#include "engine/EllipseReader.cpp"
+#include "engine/MapOscillator.cpp"
+#include "engine/RenderThreadPool.cpp"
+#include "engine/MidiRouter.cpp"
+#include "engine/SynthVoice.cpp"
+#include "engine/MapSynthesiser.cpp"
+#include "engine/ImageInEngine.cpp"
+#include "engine/EngineSettings.cpp"
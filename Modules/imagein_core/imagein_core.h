@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    imagein_core.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+/*******************************************************************************
+ The block below describes the properties of this module, and is read by
+ the Projucer to automatically generate project code that uses it.
+
+ BEGIN_JUCE_MODULE_DECLARATION
+
+  ID:                 imagein_core
+  vendor:             fxme
+  version:            0.2.0
+  name:               Image-In core
+  description:        The Image-In sound engine: image readers, modulators, voices and synths, without any GUI.
+  website:            www.fx-mechanics.com
+  license:            LGPLv3
+  minimumCppStandard: 17
+
+  dependencies:       juce_audio_basics juce_dsp juce_events juce_graphics
+
+ END_JUCE_MODULE_DECLARATION
+
+*******************************************************************************/
+
+#pragma once
+#define IMAGEIN_CORE_H_INCLUDED
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_events/juce_events.h>
+#include <juce_graphics/juce_graphics.h>
+
+#include "engine/FastMath.h"
+#include "engine/ParameterStructs.h"
+#include "engine/PhaseRotator.h"
+#include "engine/HighPrecisionImage.h"
+#include "engine/BrightnessPlane.h"
+#include "engine/TerrainFile.h"
+#include "engine/BrightnessPyramid.h"
+#include "engine/LoopWavetable.h"
+#include "engine/StateVariableFilter.h"
+#include "engine/HalfBandDecimator.h"
+#include "engine/Modulator.h"
+#include "engine/LFO.h"
+#include "engine/ADSR.h"
+#include "engine/ImageBuffer.h"
+#include "engine/BitmapDataManager.h"
+#include "engine/TerrainCache.h"
+#include "engine/ImageLoader.h"
+#include "engine/ReaderBase.h"
+#include "engine/EllipseReader.h"
+#include "engine/MapOscillator.h"
+#include "engine/TripleBuffer.h"
+#include "engine/RenderThreadPool.h"
+#include "engine/MidiRouter.h"
+#include "engine/SynthSound.h"
+#include "engine/SynthVoice.h"
+#include "engine/MapSynthesiser.h"
+#include "engine/ImageInEngine.h"
+#include "engine/EngineSettings.h"
@@ -13,7 +13,6 @@
 */
 
 #include "CircleReader.h"
-#include "LFO.h"
 
 CircleReader::CircleReader() {}
 CircleReader::~CircleReader() {}
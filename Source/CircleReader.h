@@ -14,8 +14,7 @@
 
 #pragma once
 
-#include "ReaderBase.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 #include "colours.h"
 
 class CircleReader  : public ReaderBase
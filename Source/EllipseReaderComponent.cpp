@@ -81,6 +81,12 @@ EllipseReaderComponent::EllipseReaderComponent(MapSynthAudioProcessor& p, int re
         midiChannelBox.addItemList(choiceParam->choices, 1);
     midiChannelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(p.apvts, idPrefix + "MidiChannel", midiChannelBox);
 
+    addAndMakeVisible(oversamplingBox);
+    oversamplingBox.setColour(juce::ComboBox::backgroundColourId, juce::Colours::transparentBlack);
+    oversamplingBox.setColour(juce::ComboBox::outlineColourId, juce::Colours::transparentBlack);
+    oversamplingBox.addItemList(oversamplingChoices, 1);
+    oversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(p.apvts, idPrefix + "Oversampling", oversamplingBox);
+
     onButton = std::make_unique<fxme::FxmeButton>(p.apvts, idPrefix + "On", "On", ELLIPSECOLOURS[readerIndex - 1]);
     addAndMakeVisible(*onButton);
     onButton->setLookAndFeel(&fxmeLookAndFeel);
@@ -125,6 +131,7 @@ void EllipseReaderComponent::resized()
     midiAndTogglesBox.items.add(fi(*showMasterButton).withFlex(1.f).withMargin(juce::FlexItem::Margin(0.f,10.f,0.f,10.f)));
     midiAndTogglesBox.items.add(fi(*showLFOButton).withFlex(1.f).withMargin(juce::FlexItem::Margin(0.f,10.f,0.f,10.f)));
     midiAndTogglesBox.items.add(fi(midiChannelBox).withFlex(1.f));
+    midiAndTogglesBox.items.add(fi(oversamplingBox).withFlex(0.6f));
 
     fbRow1.items.add(fi(*ellipseCxKnob).withFlex(1.f));
     fbRow1.items.add(fi(*ellipseCyKnob).withFlex(1.f));
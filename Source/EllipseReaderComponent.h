@@ -35,12 +35,14 @@ private:
 
     juce::ComboBox filterTypeBox;
     juce::ComboBox midiChannelBox;
+    juce::ComboBox oversamplingBox;
 
     std::unique_ptr<ModControlBox> modCx, modCy, modR1, modR2, modAngle, modVolume,
                                    modFilterFreq, modFilterQuality, modPan, modFreq;
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterTypeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> midiChannelAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
 
     std::unique_ptr<fxme::FxmeButton> onButton;
     std::unique_ptr<fxme::FxmeButton> showMasterButton;
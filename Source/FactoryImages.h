@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    FactoryImages.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace ImageResourceHelper
+{
+    // A struct to hold information about our image resources
+    struct ImageResource
+    {
+        juce::String friendlyName;
+        const char* resourceName; // The variable name in BinaryData
+    };
+
+    // This function now returns a list of valid image resources.
+    // The FactoryImage parameter's choice n (from 1, 0 being "Custom") is entry n - 1.
+    static juce::Array<ImageResource> getFactoryImageResources()
+    {
+        juce::Array<ImageResource> resources;
+        for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+        {
+            juce::String filename(BinaryData::originalFilenames[i]);
+            if (filename.endsWithIgnoreCase(".png") || filename.endsWithIgnoreCase(".jpg") || filename.endsWithIgnoreCase(".jpeg"))
+            {
+                resources.add({
+                    filename.fromFirstOccurrenceOf("_", false, false).upToLastOccurrenceOf(".", false, false),
+                    BinaryData::namedResourceList[i]
+                });
+            }
+        }
+        return resources;
+    }
+
+    // Starts decoding a factory image into the engine, by its FactoryImage choice.
+    // Returns false if there is no such image.
+    static bool loadFactoryImage(ImageInEngine& engine, int choiceIndex)
+    {
+        const auto imageResources = getFactoryImageResources();
+        const int resourceIndex = choiceIndex - 1; // Adjust for "Custom" item
+
+        if (! juce::isPositiveAndBelow(resourceIndex, imageResources.size()))
+            return false;
+
+        const char* resourceName = imageResources.getUnchecked(resourceIndex).resourceName;
+        int dataSize = 0;
+        const char* resourceData = BinaryData::getNamedResource(resourceName, dataSize);
+
+        if (resourceData == nullptr || dataSize <= 0)
+            return false;
+
+        engine.imageLoader.loadAsync (resourceData, (size_t) dataSize);
+        return true;
+    }
+}
@@ -16,7 +16,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 #include "colours.h"
 
 class LFOControlComponent : public juce::Component
@@ -13,7 +13,6 @@
 */
 
 #include "LineReader.h"
-#include "LFO.h"
 
 LineReader::LineReader()
 {
@@ -14,8 +14,7 @@
 
 #pragma once
 
-#include "ReaderBase.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 
 /**
     This class reads audio samples from an image by traversing a line.
@@ -21,7 +21,7 @@ MapDisplayComponent::MapDisplayComponent (MapSynthAudioProcessor& p)
 {
     setOpaque (true);
 
-    processor.imageBuffer.addChangeListener (this);
+    processor.engine.imageBuffer.addChangeListener (this);
 
     // We don't need to listen to the readers anymore, as we are repainting
     // on a timer for smooth animation.
@@ -31,7 +31,7 @@ MapDisplayComponent::MapDisplayComponent (MapSynthAudioProcessor& p)
 MapDisplayComponent::~MapDisplayComponent()
 {
     stopTimer();
-    processor.imageBuffer.removeChangeListener (this);
+    processor.engine.imageBuffer.removeChangeListener (this);
 }
 
 void MapDisplayComponent::setEditor(MapSynthAudioProcessorEditor* e)
@@ -53,7 +53,7 @@ void MapDisplayComponent::paint (juce::Graphics& g)
     if (displayArea.isEmpty())
         return;
     
-    auto image = processor.imageBuffer.getImage();
+    auto image = processor.engine.imageBuffer.getImage();
 
     if (image.isValid())
     {
@@ -66,10 +66,10 @@ void MapDisplayComponent::paint (juce::Graphics& g)
     auto& apvts = processor.apvts;
 
     // Get latest LFO values from the audio thread
-    const float lfo1Val = processor.lfo.getLatestValue();
-    const float lfo2Val = processor.lfo2.getLatestValue();
-    const float lfo3Val = processor.lfo3.getLatestValue();
-    const float lfo4Val = processor.lfo4.getLatestValue();
+    const float lfo1Val = processor.engine.getLfoValue (0);
+    const float lfo2Val = processor.engine.getLfoValue (1);
+    const float lfo3Val = processor.engine.getLfoValue (2);
+    const float lfo4Val = processor.engine.getLfoValue (3);
 
     const float w = (float) displayArea.getWidth();
     const float h = (float) displayArea.getHeight();
@@ -221,26 +221,20 @@ void MapDisplayComponent::paint (juce::Graphics& g)
 
 
     // Draw per-voice paths
-    std::array<std::array<VoiceDisplayState, NUM_VOICES>, 3> statesCopy;
-    {
-        juce::ScopedLock lock (processor.displayStateLock);
-        statesCopy = processor.voiceDisplayStates;
-    }
-
     for (int synthIndex = 0; synthIndex < 3; ++synthIndex)
     {
-        for (int voiceIndex = 0; voiceIndex < NUM_VOICES; ++voiceIndex)
+        for (int voiceIndex = 0; voiceIndex < MAX_VOICES; ++voiceIndex)
         {
-            const auto& voiceState = statesCopy[synthIndex][voiceIndex];
+            const auto& voiceState = processor.engine.voiceDisplayStates[synthIndex][voiceIndex].read();
 
             if (! voiceState.isActive)
                 continue;
 
             // A voice only has one reader, so we can get the first one.
-            if (voiceState.readerInfos.isEmpty())
+            if (voiceState.numReaders == 0)
                 continue;
 
-            const auto& readerInfo = voiceState.readerInfos.getUnchecked(0);
+            const auto& readerInfo = voiceState.readerInfos[0];
             if (readerInfo.type == ReaderBase::Type::Ellipse)
             {
                 const float alpha = readerInfo.volume;
@@ -430,7 +424,7 @@ void MapDisplayComponent::timerCallback()
 
 void MapDisplayComponent::changeListenerCallback (juce::ChangeBroadcaster* source)
 {
-    if (source == &processor.imageBuffer)
+    if (source == &processor.engine.imageBuffer)
     {
         repaint();
     }
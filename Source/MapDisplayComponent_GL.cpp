@@ -26,7 +26,7 @@ MapDisplayComponent_GL::MapDisplayComponent_GL (MapSynthAudioProcessor& p)
     openGLContext.attachTo (*this);
     openGLContext.setContinuousRepainting (false); // We'll trigger repaints from a timer
 
-    processor.imageBuffer.addChangeListener (this);
+    processor.engine.imageBuffer.addChangeListener (this);
 
     // We don't need to listen to the readers anymore, as we are repainting
     // on a timer for smooth animation.
@@ -37,7 +37,7 @@ MapDisplayComponent_GL::~MapDisplayComponent_GL()
 {
     stopTimer();
     openGLContext.detach();
-    processor.imageBuffer.removeChangeListener (this);
+    processor.engine.imageBuffer.removeChangeListener (this);
 }
 
 void MapDisplayComponent_GL::setEditor(MapSynthAudioProcessorEditor* e)
@@ -109,7 +109,7 @@ void MapDisplayComponent_GL::renderOpenGL()
     juce::gl::glViewport ((GLint) (displayArea.getX() * scale), (GLint) ((getHeight() - displayArea.getBottom()) * scale),
                           (GLsizei) (displayArea.getWidth() * scale), (GLsizei) (displayArea.getHeight() * scale));
     
-    auto image = processor.imageBuffer.getImage();
+    auto image = processor.engine.imageBuffer.getImage();
 
     if (image.isValid())
     {
@@ -145,10 +145,10 @@ void MapDisplayComponent_GL::renderOpenGL()
     auto& apvts = processor.apvts;
 
     // Get latest LFO values from the audio thread
-    const float lfo1Val = processor.lfo.getLatestValue();
-    const float lfo2Val = processor.lfo2.getLatestValue();
-    const float lfo3Val = processor.lfo3.getLatestValue();
-    const float lfo4Val = processor.lfo4.getLatestValue();
+    const float lfo1Val = processor.engine.getLfoValue (0);
+    const float lfo2Val = processor.engine.getLfoValue (1);
+    const float lfo3Val = processor.engine.getLfoValue (2);
+    const float lfo4Val = processor.engine.getLfoValue (3);
 
     const float w = (float) displayArea.getWidth();
     const float h = (float) displayArea.getHeight();
@@ -298,26 +298,20 @@ void MapDisplayComponent_GL::renderOpenGL()
 
 
     // Draw per-voice paths
-    std::array<std::array<VoiceDisplayState, NUM_VOICES>, 3> statesCopy;
-    {
-        juce::ScopedLock lock (processor.displayStateLock);
-        statesCopy = processor.voiceDisplayStates;
-    }
-
     for (int synthIndex = 0; synthIndex < 3; ++synthIndex)
     {
-        for (int voiceIndex = 0; voiceIndex < NUM_VOICES; ++voiceIndex)
+        for (int voiceIndex = 0; voiceIndex < MAX_VOICES; ++voiceIndex)
         {
-            const auto& voiceState = statesCopy[synthIndex][voiceIndex];
+            const auto& voiceState = processor.engine.voiceDisplayStates[synthIndex][voiceIndex].read();
 
             if (! voiceState.isActive)
                 continue;
 
             // A voice only has one reader, so we can get the first one.
-            if (voiceState.readerInfos.isEmpty())
+            if (voiceState.numReaders == 0)
                 continue;
 
-            const auto& readerInfo = voiceState.readerInfos.getUnchecked(0);
+            const auto& readerInfo = voiceState.readerInfos[0];
             if (readerInfo.type == ReaderBase::Type::Ellipse)
             {
                 g.setColour(ELLIPSECOLOURS[synthIndex].withAlpha(readerInfo.volume));
@@ -488,7 +482,7 @@ void MapDisplayComponent_GL::timerCallback()
 
 void MapDisplayComponent_GL::changeListenerCallback (juce::ChangeBroadcaster* source)
 {
-    if (source == &processor.imageBuffer)
+    if (source == &processor.engine.imageBuffer)
     {
         // The image has changed. Invalidate our cached image so the texture
         // gets recreated on the next render pass.
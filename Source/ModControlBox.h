@@ -15,7 +15,7 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 
 class MapSynthAudioProcessor;
 
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ParameterRegistry.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#include "ParameterRegistry.h"
+
+ParameterRegistry::ParameterRegistry (juce::AudioProcessorValueTreeState& apvts)
+{
+    auto get = [&apvts] (const juce::String& parameterID)
+    {
+        auto* handle = apvts.getRawParameterValue (parameterID);
+        jassert (handle != nullptr); // This will fire if the ID does not match createParameters()
+        return handle;
+    };
+
+    for (int i = 0; i < (int) ellipses.size(); ++i)
+    {
+        auto& e = ellipses[(size_t) i];
+        const juce::String prefix = "Ellipse" + juce::String (i + 1) + "_";
+        const juce::String modPrefix = "Mod_" + prefix;
+
+        e.on = get (prefix + "On");
+        e.showMaster = get (prefix + "ShowMaster");
+        e.midiChannel = get (prefix + "MidiChannel");
+        e.cx = get (prefix + "CX");
+        e.cy = get (prefix + "CY");
+        e.r1 = get (prefix + "R1");
+        e.r2 = get (prefix + "R2");
+        e.angle = get (prefix + "Angle");
+        e.volume = get (prefix + "Volume");
+        e.detune = get (prefix + "Detune");
+        e.pan = get (prefix + "Pan");
+        e.oversampling = get (prefix + "Oversampling");
+
+        e.modCxAmount = get (modPrefix + "CX_Amount");
+        e.modCxSelect = get (modPrefix + "CX_Select");
+        e.modCyAmount = get (modPrefix + "CY_Amount");
+        e.modCySelect = get (modPrefix + "CY_Select");
+        e.modR1Amount = get (modPrefix + "R1_Amount");
+        e.modR1Select = get (modPrefix + "R1_Select");
+        e.modR2Amount = get (modPrefix + "R2_Amount");
+        e.modR2Select = get (modPrefix + "R2_Select");
+        e.modAngleAmount = get (modPrefix + "Angle_Amount");
+        e.modAngleSelect = get (modPrefix + "Angle_Select");
+        e.modVolumeAmount = get (modPrefix + "Volume_Amount");
+        e.modVolumeSelect = get (modPrefix + "Volume_Select");
+        e.modPanAmount = get (modPrefix + "Pan_Amount");
+        e.modPanSelect = get (modPrefix + "Pan_Select");
+        e.modFreqAmount = get (modPrefix + "Freq_Amount");
+        e.modFreqSelect = get (modPrefix + "Freq_Select");
+
+        e.filterType = get (prefix + "FilterType");
+        e.filterFreq = get (prefix + "FilterFreq");
+        e.filterQuality = get (prefix + "FilterQuality");
+        e.modFilterFreqAmount = get (modPrefix + "FilterFreq_Amount");
+        e.modFilterFreqSelect = get (modPrefix + "FilterFreq_Select");
+        e.modFilterQualityAmount = get (modPrefix + "FilterQuality_Amount");
+        e.modFilterQualitySelect = get (modPrefix + "FilterQuality_Select");
+    }
+
+    // The first ADSR has no suffix, the others are numbered from 2.
+    for (int i = 0; i < (int) adsrs.size(); ++i)
+    {
+        auto& a = adsrs[(size_t) i];
+        const juce::String suffix = i == 0 ? juce::String() : juce::String (i + 1);
+
+        a.attack = get ("Attack" + suffix);
+        a.decay = get ("Decay" + suffix);
+        a.sustain = get ("Sustain" + suffix);
+        a.release = get ("Release" + suffix);
+    }
+
+    for (int i = 0; i < (int) lfos.size(); ++i)
+    {
+        auto& l = lfos[(size_t) i];
+        const juce::String prefix = "LFO" + juce::String (i + 1);
+
+        l.wave = get (prefix + "Wave");
+        l.sync = get (prefix + "Sync");
+        l.rate = get (prefix + "Rate");
+        l.freq = get (prefix + "Freq");
+        l.phase = get (prefix + "Phase");
+    }
+
+    modulationRate = get ("ModulationRate");
+    multiThreaded = get ("MultiThreaded");
+    polyphony = get ("Polyphony");
+    level = get ("Level");
+}
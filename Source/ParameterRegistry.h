@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    ParameterRegistry.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    The raw value pointers of every parameter read on the audio thread, looked up
+    once at construction so that processBlock never builds IDs or hashes strings.
+
+    It also carries a generation counter, bumped from the parameter listener on
+    any change, which lets the processor skip re-reading values that did not move.
+*/
+class ParameterRegistry
+{
+public:
+    using Handle = std::atomic<float>*;
+
+    struct EllipseHandles
+    {
+        Handle on, showMaster, midiChannel;
+        Handle cx, cy, r1, r2, angle, volume, detune, pan, oversampling;
+
+        Handle modCxAmount, modCxSelect, modCyAmount, modCySelect;
+        Handle modR1Amount, modR1Select, modR2Amount, modR2Select;
+        Handle modAngleAmount, modAngleSelect, modVolumeAmount, modVolumeSelect;
+        Handle modPanAmount, modPanSelect, modFreqAmount, modFreqSelect;
+
+        Handle filterType, filterFreq, filterQuality;
+        Handle modFilterFreqAmount, modFilterFreqSelect, modFilterQualityAmount, modFilterQualitySelect;
+    };
+
+    struct AdsrHandles
+    {
+        Handle attack, decay, sustain, release;
+    };
+
+    struct LfoHandles
+    {
+        Handle wave, sync, rate, freq, phase;
+    };
+
+    explicit ParameterRegistry (juce::AudioProcessorValueTreeState& apvts);
+
+    std::array<EllipseHandles, 3> ellipses;
+    std::array<AdsrHandles, 3> adsrs;
+    std::array<LfoHandles, 4> lfos;
+    Handle modulationRate;
+    Handle multiThreaded;
+    Handle polyphony;
+    Handle level;
+
+    /** Called by the parameter listener, from whichever thread changed the value. */
+    void markChanged() noexcept { generation.fetch_add (1, std::memory_order_release); }
+
+    juce::uint32 getGeneration() const noexcept { return generation.load (std::memory_order_acquire); }
+
+private:
+    std::atomic<juce::uint32> generation { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterRegistry)
+};
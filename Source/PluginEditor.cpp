@@ -14,7 +14,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 #include "colours.h"
 #include "LFOControlComponent.h"
 
@@ -235,9 +235,16 @@ MapSynthAudioProcessorEditor::MapSynthAudioProcessorEditor (MapSynthAudioProcess
     loadImageButton.setButtonText ("Load...");
     loadImageButton.onClick = [this]
     {
+        // While an image loads, the button cancels it.
+        if (audioProcessor.engine.imageLoader.isLoading())
+        {
+            audioProcessor.engine.imageLoader.cancel();
+            return;
+        }
+
         fileChooser = std::make_unique<juce::FileChooser> ("Select an image file...",
                                                            juce::File{},
-                                                           "*.png,*.jpg,*.jpeg,*.gif");
+                                                           "*.png,*.jpg,*.jpeg,*.gif,*.pfm,*.f32");
 
         auto chooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
 
@@ -247,16 +254,9 @@ MapSynthAudioProcessorEditor::MapSynthAudioProcessorEditor (MapSynthAudioProcess
 
             if (file != juce::File{})
             {
-                if (audioProcessor.imageBuffer.setImage (file))
-                {
-                    // If user loads an image, set the selector to "Custom"
-                    if (auto* param = audioProcessor.apvts.getParameter("FactoryImage"))
-                        param->setValueNotifyingHost(0.0f);
-                }
-                else
-                {
-                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon, "Image Load Error", "Could not load the image file: " + file.getFileName());
-                }
+                // Decoded in the background; imageLoadFinished() takes it from there.
+                fileBeingLoaded = file;
+                audioProcessor.engine.imageLoader.loadAsync (file);
             }
         });
     };
@@ -314,6 +314,24 @@ MapSynthAudioProcessorEditor::MapSynthAudioProcessorEditor (MapSynthAudioProcess
         });
     };
 
+    addAndMakeVisible(modulationRateSelector);
+    modulationRateSelector.addItemList(modulationRateChoices, 1);
+    modulationRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "ModulationRate", modulationRateSelector);
+
+    multiThreadedButton = std::make_unique<fxme::FxmeButton>(audioProcessor.apvts, "MultiThreaded", "Multi-core", juce::Colours::lightgrey);
+    addAndMakeVisible(*multiThreadedButton);
+    multiThreadedButton->setLookAndFeel(&fxmeLookAndFeel);
+
+    addAndMakeVisible(polyphonySlider);
+    polyphonySlider.setSliderStyle(juce::Slider::SliderStyle::IncDecButtons);
+    polyphonySlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
+    polyphonyAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.apvts, "Polyphony", polyphonySlider);
+
+    addAndMakeVisible(polyphonyLabel);
+    polyphonyLabel.setText("Voices", juce::dontSendNotification);
+    polyphonyLabel.setJustificationType(juce::Justification::centredRight);
+    polyphonyLabel.attachToComponent(&polyphonySlider, true);
+
     addAndMakeVisible(masterVolumeSlider);
     masterVolumeSlider.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
     masterVolumeSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 80, 20);
@@ -372,12 +390,14 @@ MapSynthAudioProcessorEditor::MapSynthAudioProcessorEditor (MapSynthAudioProcess
     setSize (1024, 512);
 
     audioProcessor.apvts.addParameterListener("ShowPanel", this);
+    audioProcessor.engine.imageLoader.addListener (this);
 
 }
 
 MapSynthAudioProcessorEditor::~MapSynthAudioProcessorEditor()
 {
     audioProcessor.apvts.removeParameterListener("ShowPanel", this);
+    audioProcessor.engine.imageLoader.removeListener (this);
 }
 
 //==============================================================================
@@ -390,6 +410,42 @@ void MapSynthAudioProcessorEditor::parameterChanged(const juce::String& paramete
     }
 }
 
+void MapSynthAudioProcessorEditor::imageLoadProgressChanged (float progress)
+{
+    const bool done = progress >= 1.0f;
+    loadImageButton.setButtonText (done ? "Load..." : "Cancel " + juce::String (juce::roundToInt (progress * 100.0f)) + "%");
+}
+
+void MapSynthAudioProcessorEditor::imageLoadFinished (const juce::File& file, bool succeeded)
+{
+    loadImageButton.setButtonText ("Load...");
+
+    // Loads started by presets or by the host are none of our business.
+    if (file != fileBeingLoaded || file == juce::File{})
+        return;
+
+    fileBeingLoaded = juce::File{};
+
+    if (succeeded)
+    {
+        // If user loads an image, set the selector to "Custom"
+        if (auto* param = audioProcessor.apvts.getParameter("FactoryImage"))
+            param->setValueNotifyingHost(0.0f);
+    }
+    else
+    {
+        juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon, "Image Load Error", "Could not load the image file: " + file.getFileName());
+    }
+}
+
+void MapSynthAudioProcessorEditor::imageLoadCancelled (const juce::File& file)
+{
+    loadImageButton.setButtonText ("Load...");
+
+    if (file == fileBeingLoaded)
+        fileBeingLoaded = juce::File{};
+}
+
 //==============================================================================
 void MapSynthAudioProcessorEditor::paint (juce::Graphics& g)
 {
@@ -430,6 +486,10 @@ void MapSynthAudioProcessorEditor::resized()
         loadImageButton.setVisible(true);        
         importStateButton.setVisible(true);
         exportStateButton.setVisible(true);
+        modulationRateSelector.setVisible(true);
+        multiThreadedButton->setVisible(true);
+        polyphonySlider.setVisible(true);
+        polyphonyLabel.setVisible(true);
         readerTabs.setVisible(true);
 
         auto leftPanelPadded = leftPanelArea.reduced(5);
@@ -449,6 +509,9 @@ void MapSynthAudioProcessorEditor::resized()
         
         importStateButton.setBounds(loadImageButton.getRight() + 10, buttonArea.getY() + 3, 60, 24);
         exportStateButton.setBounds(importStateButton.getRight() + 5, buttonArea.getY() + 3, 60, 24);
+        modulationRateSelector.setBounds(exportStateButton.getRight() + 10, buttonArea.getY() + 3, 90, 24);
+        multiThreadedButton->setBounds(fadeArea.removeFromRight(100));
+        polyphonySlider.setBounds(fadeArea.removeFromLeft(140).withTrimmedLeft(60));
 
         togglePanelButton.setButtonText("<");    
 
@@ -465,6 +528,10 @@ void MapSynthAudioProcessorEditor::resized()
         loadImageButton.setVisible(false);        
         importStateButton.setVisible(false);
         exportStateButton.setVisible(false);
+        modulationRateSelector.setVisible(false);
+        multiThreadedButton->setVisible(false);
+        polyphonySlider.setVisible(false);
+        polyphonyLabel.setVisible(false);
         readerTabs.setVisible(false);
         togglePanelButton.setButtonText(">");
     }
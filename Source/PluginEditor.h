@@ -29,7 +29,8 @@ class ADSRsComponent;
 /**
 */
 class MapSynthAudioProcessorEditor  : public juce::AudioProcessorEditor,                                      
-                                      public juce::AudioProcessorValueTreeState::Listener
+                                      public juce::AudioProcessorValueTreeState::Listener,
+                                      private ImageLoader::Listener
 {
 public:
     MapSynthAudioProcessorEditor (MapSynthAudioProcessor&);
@@ -40,6 +41,9 @@ public:
     void resized() override;
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
+    void imageLoadProgressChanged (float progress) override;
+    void imageLoadFinished (const juce::File& file, bool succeeded) override;
+    void imageLoadCancelled (const juce::File& file) override;
 
 private:
     // This reference is provided as a quick way for your editor to
@@ -68,9 +72,19 @@ private:
 
     juce::TextButton loadImageButton;
     std::unique_ptr<juce::FileChooser> fileChooser;
+    juce::File fileBeingLoaded; // The image the user picked, while it loads
     juce::TextButton importStateButton;
     juce::TextButton exportStateButton;
 
+    juce::ComboBox modulationRateSelector;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modulationRateAttachment;
+
+    std::unique_ptr<fxme::FxmeButton> multiThreadedButton;
+
+    juce::Slider polyphonySlider;
+    juce::Label polyphonyLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> polyphonyAttachment;
+
     juce::Slider masterVolumeSlider;
     juce::Label masterVolumeLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> masterVolumeAttachment;
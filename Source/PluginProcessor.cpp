@@ -15,8 +15,8 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "SynthSound.h"
 #include "FactoryPresets.h"
+#include "FactoryImages.h"
 
 namespace ParameterHelpers
 {
@@ -71,6 +71,7 @@ namespace ParameterHelpers
         layout.add(std::make_unique<juce::AudioParameterFloat>(idPrefix + "FilterFreq", namePrefix + "Filter Freq", juce::NormalisableRange<float>(20.0f, 20000.0f, 1.0f, 0.3f), 20000.0f));
         layout.add(std::make_unique<juce::AudioParameterFloat>(idPrefix + "FilterQuality", namePrefix + "Filter Q", juce::NormalisableRange<float>(0.1f, 18.0f, 0.01f), 1.0f));
         layout.add(std::make_unique<juce::AudioParameterFloat>(idPrefix + "Detune", namePrefix + "Detune", juce::NormalisableRange<float>(-12.f, 12.f, 0.01f), 0.0f));
+        layout.add(std::make_unique<juce::AudioParameterChoice>(idPrefix + "Oversampling", namePrefix + "Oversampling", oversamplingChoices, 0));
         layout.add(std::make_unique<juce::AudioParameterFloat>("Mod_" + idPrefix + "FilterFreq_Amount", "Mod->" + namePrefix + "FltFreq", juce::NormalisableRange<float>(-1.f, 1.f, .01f), 0.0f));
         layout.add(std::make_unique<juce::AudioParameterChoice>("Mod_" + idPrefix + "FilterFreq_Select", "Mod Select", modulatorChoices, 0));
         layout.add(std::make_unique<juce::AudioParameterFloat>("Mod_" + idPrefix + "FilterQuality_Amount", "Mod->" + namePrefix + "FltQ", juce::NormalisableRange<float>(-1.f, 1.f, .01f), 0.0f));
@@ -78,34 +79,6 @@ namespace ParameterHelpers
     }
 }
 
-namespace ImageResourceHelper
-{
-    // A struct to hold information about our image resources
-    struct ImageResource
-    {
-        juce::String friendlyName;
-        const char* resourceName; // The variable name in BinaryData
-    };
-
-    // This function now returns a list of valid image resources
-    static juce::Array<ImageResource> getFactoryImageResources()
-    {
-        juce::Array<ImageResource> resources;
-        for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
-        {
-            juce::String filename(BinaryData::originalFilenames[i]);
-            if (filename.endsWithIgnoreCase(".png") || filename.endsWithIgnoreCase(".jpg") || filename.endsWithIgnoreCase(".jpeg"))
-            {
-                resources.add({
-                    filename.fromFirstOccurrenceOf("_", false, false).upToLastOccurrenceOf(".", false, false),
-                    BinaryData::namedResourceList[i]
-                });
-            }
-        }
-        return resources;
-    }
-}
-
 //==============================================================================
 MapSynthAudioProcessor::MapSynthAudioProcessor()
      : AudioProcessor (BusesProperties()
@@ -117,18 +90,6 @@ MapSynthAudioProcessor::MapSynthAudioProcessor()
                      #endif
                        ), factoryPresets(FactoryPresets::getAvailablePresets())
 {    
-    for (int synthIndex = 0; synthIndex < 3; ++synthIndex)
-    {
-        synths[synthIndex].addSound(new SynthSound());
-        for (int i = 0; i < NUM_VOICES; ++i)
-        {
-            synths[synthIndex].addVoice(new SynthVoice(*this, i, synthIndex));
-        }
-    }
-
-    // This must be called after voices are created.
-    updateVoices();
-
     // Add this as a listener to all parameters to detect when the user
     // modifies the state, so we can mark the current program as "dirty".
     for (auto* param : getParameters())
@@ -190,7 +151,7 @@ bool MapSynthAudioProcessor::isMidiEffect() const
 
 double MapSynthAudioProcessor::getTailLengthSeconds() const
 {
-    return 5.0;
+    return ImageInEngine::tailLengthSeconds;
 }
 
 int MapSynthAudioProcessor::getNumPrograms()
@@ -262,32 +223,12 @@ void MapSynthAudioProcessor::changeProgramName (int index, const juce::String& n
 //==============================================================================
 void MapSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    for (auto& synth : synths)
-    {
-        synth.setCurrentPlaybackSampleRate(sampleRate);
-    }
+    engine.prepare (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
 
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = (juce::uint32) samplesPerBlock;
     spec.numChannels = (juce::uint32) getTotalNumOutputChannels();
-
-    masterLevelSmoother.reset(sampleRate, 0.05);
-
-    lfoBuffer.setSize (4, samplesPerBlock);
-
-    lfo.prepareToPlay (sampleRate);
-    lfo2.prepareToPlay (sampleRate);
-    lfo3.prepareToPlay (sampleRate);
-    lfo4.prepareToPlay (sampleRate);
-
-    // Initialise high-pass filter states
-    hpf_prevInput.clear();
-    hpf_prevOutput.clear();
-    hpf_prevInput.insertMultiple(0, 0.0f, getTotalNumOutputChannels());
-    hpf_prevOutput.insertMultiple(0, 0.0f, getTotalNumOutputChannels());
-
-    processSampleRate = sampleRate;
 }
 
 void MapSynthAudioProcessor::releaseResources()
@@ -333,43 +274,15 @@ float MapSynthAudioProcessor::getSmoothedMaxLevel(const int channel)
 }
 
 
-void MapSynthAudioProcessor::updateVoices()
-{
-    juce::Array<ReaderBase::Type> types;
-    for (int i = 0; i < 3; ++i)
-    {
-        types.clear();
-        types.add(ReaderBase::Type::Ellipse); // Only one reader type per synth
-        for (int j = 0; j < synths[i].getNumVoices(); ++j)
-        {
-            if (auto* voice = dynamic_cast<SynthVoice*>(synths[i].getVoice(j)))
-            {
-                voice->rebuildReaders(types);
-            }
-        }
-    }
-}
-
 void MapSynthAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
+    parameterRegistry.markChanged();
+
     if (parameterID == "FactoryImage")
     {
         const int choiceIndex = (int)newValue;
         if (choiceIndex > 0) // 0 is "Custom"
-        {
-            const auto imageResources = ImageResourceHelper::getFactoryImageResources();
-            const int resourceIndex = choiceIndex - 1; // Adjust for "Custom" item
-
-            if (juce::isPositiveAndBelow(resourceIndex, imageResources.size()))
-            {
-                const char* resourceName = imageResources.getUnchecked(resourceIndex).resourceName;
-                int dataSize = 0;
-                const char* resourceData = BinaryData::getNamedResource(resourceName, dataSize);
-
-                if (resourceData != nullptr && dataSize > 0)
-                    imageBuffer.setImage(juce::ImageFileFormat::loadFrom(resourceData, (size_t)dataSize));
-            }
-        }
+            ImageResourceHelper::loadFactoryImage (engine, choiceIndex);
     }
 
     // Any parameter change makes the preset "dirty" (a user preset).
@@ -382,123 +295,74 @@ void MapSynthAudioProcessor::parameterChanged(const juce::String& parameterID, f
     }
 }
 
-void MapSynthAudioProcessor::highPassFilter(juce::AudioBuffer<float>& buffer, float cutoffFreq)
+void MapSynthAudioProcessor::updateParameters()
 {
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
-
-    // Ensure state arrays are the correct size
-    jassert(hpf_prevInput.size() == numChannels);
-    jassert(hpf_prevOutput.size() == numChannels);
-
-    // Filter coefficients (RC filter)
-    float RC = 1.0f / (juce::MathConstants<float>::twoPi * cutoffFreq);
-    float dt = 1.0f / processSampleRate;
-    float alpha = RC / (RC + dt);
-
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
-        float prevInput = hpf_prevInput[channel];
-        float prevOutput = hpf_prevOutput[channel];
+    // Read the generation first: a change landing while we copy bumps it again,
+    // so it is picked up on the next block.
+    const auto generation = parameterRegistry.getGeneration();
+    if (generation == lastParameterGeneration)
+        return;
 
-        for (int n = 0; n < numSamples; ++n)
-        {
-            float input = channelData[n];
-            channelData[n] = alpha * (prevOutput + input - prevInput);
-            prevOutput = channelData[n];
-            prevInput = input;
-        }
-        hpf_prevInput.set(channel, prevInput);
-        hpf_prevOutput.set(channel, prevOutput);
-    }
-}
+    lastParameterGeneration = generation;
 
-void MapSynthAudioProcessor::updateParameters()
-{
     for (int i = 0; i < 3; ++i)
     {
-        auto& ellipseParams = globalParams.ellipses[i];
-        juce::String prefix = "Ellipse" + juce::String(i + 1) + "_";
-
-        ellipseParams.on = apvts.getRawParameterValue(prefix + "On")->load() > 0.5f;
-        ellipseParams.showMaster = apvts.getRawParameterValue(prefix + "ShowMaster")->load() > 0.5f;
-        ellipseParams.midiChannel = (int)apvts.getRawParameterValue(prefix + "MidiChannel")->load();
-        ellipseParams.cx = apvts.getRawParameterValue(prefix + "CX")->load();
-        ellipseParams.cy = apvts.getRawParameterValue(prefix + "CY")->load();
-        ellipseParams.r1 = apvts.getRawParameterValue(prefix + "R1")->load();
-        ellipseParams.r2 = apvts.getRawParameterValue(prefix + "R2")->load();
-        ellipseParams.angle = apvts.getRawParameterValue(prefix + "Angle")->load();
-        ellipseParams.volume = apvts.getRawParameterValue(prefix + "Volume")->load();
-        ellipseParams.detune = apvts.getRawParameterValue(prefix + "Detune")->load();
-        ellipseParams.detune = apvts.getRawParameterValue(prefix + "Detune")->load();
-        ellipseParams.pan = apvts.getRawParameterValue(prefix + "Pan")->load();
-
-        ellipseParams.modCxAmount = apvts.getRawParameterValue("Mod_" + prefix + "CX_Amount")->load();
-        ellipseParams.modCxSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "CX_Select")->load();
-        ellipseParams.modCyAmount = apvts.getRawParameterValue("Mod_" + prefix + "CY_Amount")->load();
-        ellipseParams.modCySelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "CY_Select")->load();
-        ellipseParams.modR1Amount = apvts.getRawParameterValue("Mod_" + prefix + "R1_Amount")->load();
-        ellipseParams.modR1Select = (int)apvts.getRawParameterValue("Mod_" + prefix + "R1_Select")->load();
-        ellipseParams.modR2Amount = apvts.getRawParameterValue("Mod_" + prefix + "R2_Amount")->load();
-        ellipseParams.modR2Select = (int)apvts.getRawParameterValue("Mod_" + prefix + "R2_Select")->load();
-        ellipseParams.modAngleAmount = apvts.getRawParameterValue("Mod_" + prefix + "Angle_Amount")->load();
-        ellipseParams.modAngleSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "Angle_Select")->load();
-        ellipseParams.modVolumeAmount = apvts.getRawParameterValue("Mod_" + prefix + "Volume_Amount")->load();
-        ellipseParams.modVolumeSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "Volume_Select")->load();
-        ellipseParams.modPanAmount = apvts.getRawParameterValue("Mod_" + prefix + "Pan_Amount")->load();
-        ellipseParams.modPanSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "Pan_Select")->load();
-        ellipseParams.modFreqAmount = apvts.getRawParameterValue("Mod_" + prefix + "Freq_Amount")->load();
-        ellipseParams.modFreqSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "Freq_Select")->load();
-
-        ellipseParams.filter.type = (int)apvts.getRawParameterValue(prefix + "FilterType")->load();
-        ellipseParams.filter.frequency = apvts.getRawParameterValue(prefix + "FilterFreq")->load();
-        ellipseParams.filter.quality = apvts.getRawParameterValue(prefix + "FilterQuality")->load();
-        ellipseParams.filter.modFreqAmount = apvts.getRawParameterValue("Mod_" + prefix + "FilterFreq_Amount")->load();
-        ellipseParams.filter.modFreqSelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "FilterFreq_Select")->load();
-        ellipseParams.filter.modQualityAmount = apvts.getRawParameterValue("Mod_" + prefix + "FilterQuality_Amount")->load();
-        ellipseParams.filter.modQualitySelect = (int)apvts.getRawParameterValue("Mod_" + prefix + "FilterQuality_Select")->load();
+        auto& ellipseParams = engine.globalParams.ellipses[i];
+        const auto& e = parameterRegistry.ellipses[(size_t) i];
+
+        ellipseParams.on = e.on->load() > 0.5f;
+        ellipseParams.showMaster = e.showMaster->load() > 0.5f;
+        ellipseParams.midiChannel = (int)e.midiChannel->load();
+        ellipseParams.cx = e.cx->load();
+        ellipseParams.cy = e.cy->load();
+        ellipseParams.r1 = e.r1->load();
+        ellipseParams.r2 = e.r2->load();
+        ellipseParams.angle = e.angle->load();
+        ellipseParams.volume = e.volume->load();
+        ellipseParams.detune = e.detune->load();
+        ellipseParams.pan = e.pan->load();
+        ellipseParams.oversampling = (int)e.oversampling->load();
+
+        ellipseParams.modCxAmount = e.modCxAmount->load();
+        ellipseParams.modCxSelect = (int)e.modCxSelect->load();
+        ellipseParams.modCyAmount = e.modCyAmount->load();
+        ellipseParams.modCySelect = (int)e.modCySelect->load();
+        ellipseParams.modR1Amount = e.modR1Amount->load();
+        ellipseParams.modR1Select = (int)e.modR1Select->load();
+        ellipseParams.modR2Amount = e.modR2Amount->load();
+        ellipseParams.modR2Select = (int)e.modR2Select->load();
+        ellipseParams.modAngleAmount = e.modAngleAmount->load();
+        ellipseParams.modAngleSelect = (int)e.modAngleSelect->load();
+        ellipseParams.modVolumeAmount = e.modVolumeAmount->load();
+        ellipseParams.modVolumeSelect = (int)e.modVolumeSelect->load();
+        ellipseParams.modPanAmount = e.modPanAmount->load();
+        ellipseParams.modPanSelect = (int)e.modPanSelect->load();
+        ellipseParams.modFreqAmount = e.modFreqAmount->load();
+        ellipseParams.modFreqSelect = (int)e.modFreqSelect->load();
+
+        ellipseParams.filter.type = (int)e.filterType->load();
+        ellipseParams.filter.frequency = e.filterFreq->load();
+        ellipseParams.filter.quality = e.filterQuality->load();
+        ellipseParams.filter.modFreqAmount = e.modFilterFreqAmount->load();
+        ellipseParams.filter.modFreqSelect = (int)e.modFilterFreqSelect->load();
+        ellipseParams.filter.modQualityAmount = e.modFilterQualityAmount->load();
+        ellipseParams.filter.modQualitySelect = (int)e.modFilterQualitySelect->load();
     }
 
-    // ADSR
-    globalParams.adsr.attack = apvts.getRawParameterValue ("Attack")->load();
-    globalParams.adsr.decay = apvts.getRawParameterValue ("Decay")->load();
-    globalParams.adsr.sustain = apvts.getRawParameterValue ("Sustain")->load();
-    globalParams.adsr.release = apvts.getRawParameterValue ("Release")->load();
-
-    // ADSR 2
-    globalParams.adsr2.attack = apvts.getRawParameterValue ("Attack2")->load();
-    globalParams.adsr2.decay = apvts.getRawParameterValue ("Decay2")->load();
-    globalParams.adsr2.sustain = apvts.getRawParameterValue ("Sustain2")->load();
-    globalParams.adsr2.release = apvts.getRawParameterValue ("Release2")->load();
-
-    // ADSR 3
-    globalParams.adsr3.attack = apvts.getRawParameterValue ("Attack3")->load();
-    globalParams.adsr3.decay = apvts.getRawParameterValue ("Decay3")->load();
-    globalParams.adsr3.sustain = apvts.getRawParameterValue ("Sustain3")->load();
-    globalParams.adsr3.release = apvts.getRawParameterValue ("Release3")->load();
-}
+    const int modulationRate = juce::jlimit(0, modulationRateChoices.size() - 1, (int)parameterRegistry.modulationRate->load());
+    engine.globalParams.modulationInterval = modulationIntervals[modulationRate];
+    engine.globalParams.polyphony = (int)parameterRegistry.polyphony->load();
 
-float getRateMultiplier(int choice)
-{
-    // These are multipliers for a base frequency of 1 beat (a quarter note)
-    switch (choice)
+    // ADSRs
+    std::array<ADSRParameters*, 3> adsrParams { &engine.globalParams.adsr, &engine.globalParams.adsr2, &engine.globalParams.adsr3 };
+
+    for (size_t i = 0; i < adsrParams.size(); ++i)
     {
-        case 0:  return 8.0f;        // 1/32
-        case 1:  return 4.0f * 1.5f; // 1/16T
-        case 2:  return 4.0f;        // 1/16
-        case 3:  return 4.0f / 1.5f; // 1/16D
-        case 4:  return 2.0f * 1.5f; // 1/8T
-        case 5:  return 2.0f;        // 1/8
-        case 6:  return 2.0f / 1.5f; // 1/8D
-        case 7:  return 1.0f * 1.5f; // 1/4T
-        case 8:  return 1.0f;        // 1/4
-        case 9:  return 1.0f / 1.5f; // 1/4D
-        case 10: return 0.5f * 1.5f; // 1/2T
-        case 11: return 0.5f;        // 1/2
-        case 12: return 0.5f / 1.5f; // 1/2D
-        case 13: return 0.25f;       // 1 Bar
-        default: return 1.0f;
+        const auto& a = parameterRegistry.adsrs[i];
+        adsrParams[i]->attack = a.attack->load();
+        adsrParams[i]->decay = a.decay->load();
+        adsrParams[i]->sustain = a.sustain->load();
+        adsrParams[i]->release = a.release->load();
     }
 }
 
@@ -508,28 +372,7 @@ void MapSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
 
     updateParameters();
 
-    masterLevelSmoother.setTargetValue(juce::Decibels::decibelsToGain(apvts.getRawParameterValue("Level")->load()));
-
-    buffer.clear();
-
-    // Split MIDI buffer by channel for each synth
-    std::array<juce::MidiBuffer, 3> midiBuffers;
-    for (int i = 0; i < 3; ++i)
-    {
-        const int targetChannel = globalParams.ellipses[i].midiChannel;
-        if (targetChannel == 0) // Omni
-        {
-            midiBuffers[i].addEvents(midiMessages, 0, -1, 0);
-        }
-        else
-        {
-            for (const auto metadata : midiMessages)
-            {
-                if (metadata.getMessage().getChannel() == targetChannel)
-                    midiBuffers[i].addEvent(metadata.getMessage(), metadata.samplePosition);
-            }
-        }
-    }
+    engine.setOutputLevel (parameterRegistry.level->load());
 
     double bpm = 120.0;
     if (auto* playHead = getPlayHead())
@@ -544,91 +387,27 @@ void MapSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
         }
     }
 
-    auto getLfoFreq = [&] (const char* syncId, const char* rateId, const char* freqId)
+    auto getLfoFreq = [&] (const ParameterRegistry::LfoHandles& handles)
     {
-        auto* syncParam = apvts.getRawParameterValue(syncId);
-        jassert (syncParam != nullptr); // This will fire in a debug build if the syncId is wrong
-
-        if (syncParam != nullptr && syncParam->load() > 0.5f)
+        if (handles.sync->load() > 0.5f)
         {
-            auto* rateParam = apvts.getRawParameterValue(rateId);
-            jassert (rateParam != nullptr); // This will fire if the rateId is wrong
-
-            if (rateParam == nullptr)
-                return 1.0f; // Fallback to prevent crash in release build
-
-            const int rateIndex = (int)rateParam->load();
-            const float multiplier = getRateMultiplier(rateIndex);
+            const int rateIndex = (int)handles.rate->load();
+            const float multiplier = getTempoSyncRateMultiplier(rateIndex);
             return (float) (bpm / 60.0 * multiplier);
         }
-        
-        auto* freqParam = apvts.getRawParameterValue(freqId);
-        jassert (freqParam != nullptr); // This will fire if the freqId is wrong
 
-        if (freqParam != nullptr)
-            return freqParam->load();
-        
-        return 1.0f; // Fallback
+        return handles.freq->load();
     };
 
     // Set up the LFOs
-
-    lfo.setWaveform((LFO::Waveform)(int)apvts.getRawParameterValue("LFO1Wave")->load());
-    lfo.setFrequency(getLfoFreq("LFO1Sync", "LFO1Rate", "LFO1Freq"));
-    lfo.setPhaseOffset(apvts.getRawParameterValue("LFO1Phase")->load());
-
-    lfo2.setWaveform((LFO::Waveform)(int)apvts.getRawParameterValue("LFO2Wave")->load());
-    lfo2.setFrequency(getLfoFreq("LFO2Sync", "LFO2Rate", "LFO2Freq"));
-    lfo2.setPhaseOffset(apvts.getRawParameterValue("LFO2Phase")->load());
-
-    lfo3.setWaveform((LFO::Waveform)(int)apvts.getRawParameterValue("LFO3Wave")->load());
-    lfo3.setFrequency(getLfoFreq("LFO3Sync", "LFO3Rate", "LFO3Freq"));
-    lfo3.setPhaseOffset(apvts.getRawParameterValue("LFO3Phase")->load());
-
-    lfo4.setWaveform((LFO::Waveform)(int)apvts.getRawParameterValue("LFO4Wave")->load());
-    lfo4.setFrequency(getLfoFreq("LFO4Sync", "LFO4Rate", "LFO4Freq"));
-    lfo4.setPhaseOffset(apvts.getRawParameterValue("LFO4Phase")->load());
-
-    // Process LFOs for the block
-    auto* lfo1Data = lfoBuffer.getWritePointer (0);
-    auto* lfo2Data = lfoBuffer.getWritePointer (1);
-    auto* lfo3Data = lfoBuffer.getWritePointer (2);
-    auto* lfo4Data = lfoBuffer.getWritePointer (3);
-
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    for (int i = 0; i < ImageInEngine::numLfos; ++i)
     {
-        lfo1Data[i] = lfo.process();
-        lfo2Data[i] = lfo2.process();
-        lfo3Data[i] = lfo3.process();
-        lfo4Data[i] = lfo4.process();
+        const auto& handles = parameterRegistry.lfos[(size_t) i];
+        engine.setLfo (i, (LFO::Waveform)(int)handles.wave->load(), getLfoFreq(handles), handles.phase->load());
     }
 
-    for (int i = 0; i < 3; ++i)
-    {
-        const auto& params = globalParams.ellipses[i];
-        if (params.on) {
-            synths[i].renderNextBlock(buffer, midiBuffers[i], 0, buffer.getNumSamples());
-        }
-        else if (params.wasOn) // It was on, but now it's off
-        {
-            synths[i].allNotesOff(0, false); // Kill all notes for this synth
-
-            // Manually update the display state and reset the ADSRs for the voices of the turned-off synth
-            juce::ScopedLock lock(displayStateLock);
-            for (int voiceIndex = 0; voiceIndex < NUM_VOICES; ++voiceIndex)
-            {
-                if (auto* voice = getVoice(i, voiceIndex))
-                {
-                    voice->resetADSRs();
-                }
-                voiceDisplayStates[i][voiceIndex].isActive = false;
-            }
-        }
-    }
-
-    masterLevelSmoother.applyGain(buffer, buffer.getNumSamples());
-
-    highPassFilter(buffer, 15.0f);
+    engine.setMultiThreaded (parameterRegistry.multiThreaded->load() > 0.5f);
+    engine.process (buffer, midiMessages);
 
     // Vu-Meter
     for (int i=0; i<2; ++i)
@@ -668,7 +447,8 @@ void MapSynthAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // The "FactoryImage" parameter will be at index 0 ("Custom").
     if (static_cast<int>(apvts.getRawParameterValue("FactoryImage")->load()) == 0)
     {
-        auto imageFile = imageBuffer.getFile();
+        // The image being loaded, if any: it is what the state now refers to.
+        auto imageFile = engine.imageLoader.getFile();
         if (imageFile.existsAsFile())
         {
             xml->setAttribute ("imagePath", imageFile.getFullPathName());
@@ -698,8 +478,9 @@ void MapSynthAudioProcessor::setStateInformation (const void* data, int sizeInBy
             if (xmlState->hasAttribute ("imagePath"))
             {
                 auto imagePath = xmlState->getStringAttribute ("imagePath");
+                // Decoded in the background so that a large image doesn't hold up the host.
                 // This will fail silently if file not found, which is acceptable.
-                imageBuffer.setImage (juce::File (imagePath));
+                engine.imageLoader.loadAsync (juce::File (imagePath));
             }
 
             // This is useful for creating new factory presets.
@@ -717,6 +498,7 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 
 juce::AudioProcessorValueTreeState::ParameterLayout MapSynthAudioProcessor::createParameters()
 {
+    // The tools read presets with EngineSettings, which must follow these IDs and defaults.
     // Get the list of image resources
     static const auto imageResources = ImageResourceHelper::getFactoryImageResources();
     
@@ -732,6 +514,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout MapSynthAudioProcessor::crea
     layout.add(std::make_unique<juce::AudioParameterFloat>("Level","Level",juce::NormalisableRange<float>(-60.f,12.f,1e-2f,1.f),0.f));
 
     layout.add(std::make_unique<juce::AudioParameterBool>("ShowPanel", "Show Panel", true));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("ModulationRate", "Modulation Rate", modulationRateChoices, 0));
+    layout.add(std::make_unique<juce::AudioParameterBool>("MultiThreaded", "Multi-threaded Rendering", false));
+    layout.add(std::make_unique<juce::AudioParameterInt>("Polyphony", "Polyphony", 1, MAX_VOICES, 4));
 
     layout.add(std::make_unique<juce::AudioParameterFloat>("LFO1Freq", "LFO 1 Freq", juce::NormalisableRange<float>(0.01f, 200.0f, 0.01f, 0.3f), 1.0f));
     layout.add(std::make_unique<juce::AudioParameterBool>("LFO1Sync", "LFO 1 Sync", false));
@@ -16,24 +16,12 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "MapOscillator.h"
-#include "LFO.h"
-#include "SynthSound.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 #include "FactoryPresets.h"
-#include "SynthVoice.h"
-#include "BitmapDataManager.h"
+#include "ParameterRegistry.h"
 
-// Number of voices for the synth
-#define NUM_VOICES 4
 #define NUM_METER_CHANNELS 2
 
-struct VoiceDisplayState
-{
-    bool isActive = false;
-    juce::Array<ReaderBase::DrawingInfo> readerInfos;
-};
-
 
 //==============================================================================
 /**
@@ -81,43 +69,24 @@ public:
 
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
-    ImageBuffer imageBuffer;
-    BitmapDataManager bitmapDataManager { imageBuffer };
+    ImageInEngine engine; // The image, synths and LFOs; globalParams is filled from apvts
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameters()};
-    LFO lfo;
-    LFO lfo2;
-    LFO lfo3;
-    LFO lfo4;
-    juce::AudioBuffer<float> lfoBuffer;
-    GlobalParameters globalParams; // This now contains all parameter structs
-
-    std::array<std::array<VoiceDisplayState, NUM_VOICES>, 3> voiceDisplayStates;
-    juce::CriticalSection displayStateLock;
+    ParameterRegistry parameterRegistry { apvts };
 
     float getSmoothedMaxLevel(const int channel);
     float getMaxLevel(const int channel);
 
-    SynthVoice* getVoice(int synthIndex, int voiceIndex) const { return dynamic_cast<SynthVoice*>(synths[synthIndex].getVoice(voiceIndex)); }
-
 private:
     // Preset Management
     int currentProgram = 0;
     const juce::Array<FactoryPresets::Preset> factoryPresets;
     bool isLoadingPreset = false;
 
-    double processSampleRate = 44100.0;
+    juce::uint32 lastParameterGeneration = 0; // generation globalParams was last filled from
 
-    std::array<juce::Synthesiser, 3> synths;
-    juce::LinearSmoothedValue<float> masterLevelSmoother;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameters();  
     
-    void highPassFilter(juce::AudioBuffer<float>& buffer, float cutoffFreq);
     void updateParameters();
-    void updateVoices();
-
-    // State for the high-pass filter
-    juce::Array<float> hpf_prevInput;
-    juce::Array<float> hpf_prevOutput;
 
     juce::LinearSmoothedValue<float> smoothedMaxLevel[NUM_METER_CHANNELS]; 
     float maxLevel[NUM_METER_CHANNELS];
@@ -14,7 +14,7 @@
 
 #include "ReaderComponent.h"
 #include "PluginProcessor.h"
-#include "ParameterStructs.h"
+#include <imagein_core/imagein_core.h>
 
 ReaderComponent::ReaderComponent(MapSynthAudioProcessor& p) : audioProcessor(p)
 {
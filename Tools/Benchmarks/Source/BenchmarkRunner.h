@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    A small timer harness: runs a case until it has been timed for long enough,
+    keeps the fastest of a few repetitions and collects the results.
+
+    A case renders blocks of audio; each call of its body must process
+    samplesPerCall samples for instancesPerCall voices (or readers, or LFOs).
+    Results are given in ns per sample of one instance, and as the number of
+    instances one core could run in real time at 48 kHz.
+*/
+class BenchmarkRunner
+{
+public:
+    struct Result
+    {
+        juce::String name;
+        juce::NamedValueSet parameters;
+        double nsPerSample = 0.0;    // for one instance
+        double instancesPerCore = 0.0; // at 48 kHz
+        juce::int64 iterations = 0;
+    };
+
+    BenchmarkRunner (double minSecondsPerRepetition, int numRepetitions, const juce::String& nameFilter)
+        : minSeconds (minSecondsPerRepetition), repetitions (juce::jmax (1, numRepetitions)), filter (nameFilter)
+    {
+    }
+
+    /** True if a case called name would run; lets callers skip expensive setup. */
+    bool isSelected (const juce::String& name) const
+    {
+        return filter.isEmpty() || name.containsIgnoreCase (filter);
+    }
+
+    /** Times body, which must process samplesPerCall samples of instancesPerCall instances. */
+    void run (const juce::String& name, const juce::NamedValueSet& parameters,
+              int samplesPerCall, int instancesPerCall, const std::function<void()>& body)
+    {
+        if (! isSelected (name))
+            return;
+
+        // Warm the caches and let any lazily built state settle.
+        for (int i = 0; i < 8; ++i)
+            body();
+
+        const auto minTicks = juce::Time::secondsToHighResolutionTicks (minSeconds);
+        double bestNsPerCall = std::numeric_limits<double>::max();
+        juce::int64 totalIterations = 0;
+
+        for (int repetition = 0; repetition < repetitions; ++repetition)
+        {
+            juce::int64 iterations = 0;
+            const auto start = juce::Time::getHighResolutionTicks();
+            auto elapsed = (juce::int64) 0;
+
+            while (elapsed < minTicks)
+            {
+                body();
+                ++iterations;
+                elapsed = juce::Time::getHighResolutionTicks() - start;
+            }
+
+            totalIterations += iterations;
+            bestNsPerCall = juce::jmin (bestNsPerCall, juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e9 / (double) iterations);
+        }
+
+        Result result;
+        result.name = name;
+        result.parameters = parameters;
+        result.nsPerSample = bestNsPerCall / ((double) samplesPerCall * (double) instancesPerCall);
+        result.instancesPerCore = result.nsPerSample > 0.0 ? 1.0e9 / 48000.0 / result.nsPerSample : 0.0;
+        result.iterations = totalIterations;
+
+        std::cout << result.name.paddedRight (' ', 48)
+                  << juce::String (result.nsPerSample, 2).paddedLeft (' ', 12) << " ns/sample"
+                  << juce::String (result.instancesPerCore, 1).paddedLeft (' ', 12) << " per core @48k" << std::endl;
+
+        results.add (result);
+    }
+
+    /** All results as JSON, with enough context to compare two runs. */
+    juce::String toJson() const
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty ("version", juce::String (ProjectInfo::versionString));
+        root->setProperty ("date", juce::Time::getCurrentTime().toISO8601 (true));
+        root->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty ("numCores", juce::SystemStats::getNumPhysicalCpus());
+        root->setProperty ("os", juce::SystemStats::getOperatingSystemName());
+
+        juce::Array<juce::var> cases;
+
+        for (const auto& result : results)
+        {
+            auto* item = new juce::DynamicObject();
+            item->setProperty ("name", result.name);
+
+            auto* parameters = new juce::DynamicObject();
+            for (const auto& parameter : result.parameters)
+                parameters->setProperty (parameter.name, parameter.value);
+
+            item->setProperty ("parameters", juce::var (parameters));
+            item->setProperty ("nsPerSample", result.nsPerSample);
+            item->setProperty ("instancesPerCoreAt48k", result.instancesPerCore);
+            item->setProperty ("iterations", result.iterations);
+            cases.add (juce::var (item));
+        }
+
+        root->setProperty ("benchmarks", cases);
+        return juce::JSON::toString (juce::var (root));
+    }
+
+private:
+    const double minSeconds;
+    const int repetitions;
+    const juce::String filter;
+    juce::Array<Result> results;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkRunner)
+};
@@ -0,0 +1,529 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+// Micro-benchmarks of the audio hot paths.
+//
+//   Benchmarks [--filter <text>] [--json <file>] [--min-time <seconds>]
+//              [--repetitions <n>] [--quick]
+//
+// Each case prints ns per sample (for one reader, voice, LFO...) and how many
+// of them one core could run in real time at 48 kHz. --json writes the same
+// results to a file that can be diffed between releases. --quick leaves out
+// the 8192 x 8192 image, which needs about 600 MB.
+
+#include <JuceHeader.h>
+#include "BenchmarkRunner.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    /** A smooth pattern with some fine detail, so every pyramid level differs. */
+    juce::Image createTestImage (int size)
+    {
+        juce::Image image (juce::Image::RGB, size, size, false);
+        const juce::Image::BitmapData bitmapData (image, juce::Image::BitmapData::writeOnly);
+        juce::Random random (size);
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const float u = (float) x / (float) size, v = (float) y / (float) size;
+                const float value = 0.5f + 0.35f * std::sin (40.0f * u) * std::cos (27.0f * v)
+                                         + 0.15f * (random.nextFloat() - 0.5f);
+                const auto level = (juce::uint8) juce::jlimit (0, 255, (int) (value * 255.0f));
+
+                auto* p = bitmapData.getPixelPointer (x, y);
+                p[0] = p[1] = p[2] = level;
+            }
+        }
+
+        return image;
+    }
+
+    /** Slow, distinct curves in [0, 1] for every modulator channel. */
+    void fillModulators (juce::AudioBuffer<float>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer (channel);
+            const float increment = juce::MathConstants<float>::twoPi * (0.5f + (float) channel) / (float) sampleRate;
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = 0.5f + 0.5f * std::sin (increment * (float) i);
+        }
+    }
+
+    struct ModulationConfig
+    {
+        const char* name;
+        int interval;
+        bool geometry, levels, filter;
+    };
+
+    const ModulationConfig modulationConfigs[]
+    {
+        { "static",            1, false, false, false }, // plays back from the loop wavetable
+        { "geometry",          1, true,  false, false },
+        { "geometry-every-16", 16, true, false, false },
+        { "full",              1, true,  true,  true  },
+    };
+
+    EllipseReaderParameters makeEllipseParameters (const ModulationConfig& config)
+    {
+        EllipseReaderParameters params;
+        params.r1 = 0.3f;
+        params.r2 = 0.2f;
+        params.angle = 0.4f;
+
+        if (config.geometry)
+        {
+            params.modCxAmount = 0.2f;     params.modCxSelect = ModulatorSources::LFO1;
+            params.modR1Amount = 0.3f;     params.modR1Select = ModulatorSources::LFO2;
+            params.modAngleAmount = 0.5f;  params.modAngleSelect = ModulatorSources::LFO3;
+        }
+
+        if (config.levels)
+        {
+            params.modVolumeAmount = 1.0f; params.modVolumeSelect = ModulatorSources::ADSR1;
+            params.modPanAmount = 0.5f;    params.modPanSelect = ModulatorSources::LFO4;
+            params.modFreqAmount = 0.1f;   params.modFreqSelect = ModulatorSources::LFO1_ADSR2;
+        }
+
+        if (config.filter)
+        {
+            params.filter.frequency = 2000.0f;
+            params.filter.quality = 3.0f;
+            params.filter.modFreqAmount = 0.3f;
+            params.filter.modFreqSelect = ModulatorSources::LFO2;
+        }
+
+        return params;
+    }
+
+    juce::NamedValueSet makeParameters (std::initializer_list<juce::NamedValueSet::NamedValue> values)
+    {
+        juce::NamedValueSet set;
+        for (const auto& value : values)
+            set.set (value.name, value.value);
+        return set;
+    }
+
+    //==============================================================================
+    void benchmarkReaders (BenchmarkRunner& runner, bool quick)
+    {
+        const int blockSizes[] { 64, 256, 1024 };
+        juce::Array<int> imageSizes { 256, 1024, 4096 };
+
+        if (! quick)
+            imageSizes.add (8192);
+
+        auto getCaseName = [] (const ModulationConfig& config, int imageSize, int blockSize)
+        {
+            return "reader/" + juce::String (config.name) + "/" + juce::String (imageSize) + "px/" + juce::String (blockSize);
+        };
+
+        for (auto imageSize : imageSizes)
+        {
+            // Building the larger pyramids takes a while, so only do it if a case needs them.
+            bool isNeeded = false;
+
+            for (const auto& config : modulationConfigs)
+                for (auto blockSize : blockSizes)
+                    isNeeded = isNeeded || runner.isSelected (getCaseName (config, imageSize, blockSize));
+
+            if (! isNeeded)
+                continue;
+
+            const BrightnessPyramid pyramid (createTestImage (imageSize));
+
+            for (const auto& config : modulationConfigs)
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    const auto params = makeEllipseParameters (config);
+                    SharedLoopWavetable loopWavetable;
+                    EllipseReader reader;
+                    reader.setLoopWavetable (&loopWavetable);
+                    reader.prepareToPlay (sampleRate);
+                    reader.updateParameters (params);
+                    reader.setModulationInterval (config.interval);
+                    reader.setFrequency (220.0f);
+
+                    juce::AudioBuffer<float> output (2, blockSize);
+                    juce::AudioBuffer<float> modulators (ModulatorSources::NumModulators, blockSize);
+                    fillModulators (modulators);
+
+                    // One block to ask for the loop, which the synth would then build before the next.
+                    reader.processBlock (pyramid, output, 0, blockSize, modulators);
+                    loopWavetable.update (pyramid, EllipseReader::getSettledGeometry (params));
+
+                    runner.run (getCaseName (config, imageSize, blockSize),
+                                makeParameters ({ { "imageSize", imageSize }, { "blockSize", blockSize }, { "modulation", config.name } }),
+                                blockSize, 1, [&]
+                                {
+                                    juce::ScopedNoDenormals noDenormals;
+                                    output.clear();
+                                    reader.processBlock (pyramid, output, 0, blockSize, modulators);
+                                });
+                }
+            }
+        }
+    }
+
+    /** A set-associative LRU cache of fixed-size blocks, to count the cache lines
+        or pages a sampling pattern misses, whatever the machine it runs on. */
+    class CacheModel
+    {
+    public:
+        CacheModel (int blockBytes, int numSets, int numWays)
+            : blockShift (juce::roundToInt (std::log2 ((double) blockBytes))),
+              sets ((size_t) numSets), ways ((size_t) numWays),
+              tags (sets * ways, ~(juce::uint64) 0), ages (sets * ways, 0)
+        {
+        }
+
+        int getBlockBytes() const noexcept { return 1 << blockShift; }
+        size_t getCapacity() const noexcept { return sets * ways; }
+
+        void access (const void* address) noexcept
+        {
+            const auto block = (juce::uint64) (juce::pointer_sized_uint) address >> blockShift;
+            auto* setTags = tags.data() + (size_t) (block % sets) * ways;
+            auto* setAges = ages.data() + (size_t) (block % sets) * ways;
+            size_t victim = 0;
+
+            ++clock;
+            ++accesses;
+
+            for (size_t i = 0; i < ways; ++i)
+            {
+                if (setTags[i] == block)
+                {
+                    setAges[i] = clock;
+                    return;
+                }
+
+                if (setAges[i] < setAges[victim])
+                    victim = i;
+            }
+
+            setTags[victim] = block;
+            setAges[victim] = clock;
+            ++misses;
+        }
+
+        juce::int64 misses = 0, accesses = 0;
+
+    private:
+        const int blockShift;
+        const size_t sets, ways;
+        std::vector<juce::uint64> tags, ages;
+        juce::uint64 clock = 0;
+    };
+
+    /** Ellipses like a full polyphony of readers would sweep, in pixels of a plane.
+        They move by less than a pixel per sample: any faster and the pyramid
+        would have the readers sample a coarser level.
+    */
+    struct EllipsePath
+    {
+        float cx, cy, r1, r2, phase, increment;
+    };
+
+    std::vector<EllipsePath> makeEllipsePaths (int size)
+    {
+        std::vector<EllipsePath> paths;
+        juce::Random random (size);
+        const float scale = (float) (size - 1);
+
+        for (int i = 0; i < 12; ++i)
+        {
+            EllipsePath path;
+            path.cx = scale * (0.35f + 0.3f * random.nextFloat());
+            path.cy = scale * (0.35f + 0.3f * random.nextFloat());
+            path.r1 = scale * (0.1f + 0.2f * random.nextFloat());
+            path.r2 = scale * (0.1f + 0.2f * random.nextFloat());
+            path.phase = 0.0f;
+            path.increment = (0.3f + 0.6f * random.nextFloat()) / juce::jmax (path.r1, path.r2);
+            paths.push_back (path);
+        }
+
+        return paths;
+    }
+
+    template <typename Visitor>
+    void sweepEllipses (std::vector<EllipsePath>& paths, int numSamples, Visitor&& visit)
+    {
+        for (auto& path : paths)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                visit (path.cx + path.r1 * std::cos (path.phase), path.cy + path.r2 * std::sin (path.phase));
+                path.phase += path.increment;
+            }
+
+            path.phase = std::fmod (path.phase, juce::MathConstants<float>::twoPi);
+        }
+    }
+
+    /** Bilinear lookups alone, on both plane layouts. Besides the time, each case
+        reports the L1 lines and TLB pages the lookups miss in a simulated cache,
+        so the difference shows even on a machine with large caches.
+    */
+    void benchmarkPlaneLayouts (BenchmarkRunner& runner, bool quick)
+    {
+        constexpr int blockSize = 512;
+        juce::Array<int> imageSizes { 1024, 4096 };
+
+        if (! quick)
+            imageSizes.add (8192);
+
+        const std::pair<BrightnessPlane::Layout, const char*> layouts[]
+        {
+            { BrightnessPlane::Layout::rowMajor, "rowMajor" },
+            { BrightnessPlane::Layout::tiled,    "tiled" },
+        };
+
+        for (auto imageSize : imageSizes)
+        {
+            for (const auto& layout : layouts)
+            {
+                const auto name = "plane/" + juce::String (layout.second) + "/" + juce::String (imageSize) + "px";
+
+                if (! runner.isSelected (name))
+                    continue;
+
+                const BrightnessPyramid pyramid (createTestImage (imageSize), nullptr, layout.first);
+                const auto& plane = pyramid.getLevel (0);
+                auto paths = makeEllipsePaths (imageSize);
+
+                // 32 KB of 64-byte lines, 8-way; 64 pages of 4 KB, 4-way.
+                CacheModel lines (64, 64, 8), pages (4096, 16, 4);
+
+                sweepEllipses (paths, 48000, [&] (float x, float y)
+                {
+                    const auto* p = plane.data + plane.getSampleIndex ((int) x, (int) y);
+
+                    for (const auto* tap : { p, p + 1, p + plane.getRowStep(), p + plane.getRowStep() + 1 })
+                    {
+                        lines.access (tap);
+                        pages.access (tap);
+                    }
+                });
+
+                const auto samples = (double) lines.accesses / 4.0;
+                volatile float sink = 0.0f; // Keeps the lookups from being optimised away
+
+                runner.run (name,
+                            makeParameters ({ { "imageSize", imageSize }, { "layout", layout.second }, { "readers", (int) paths.size() },
+                                              { "lineMissesPerSample", lines.misses / samples },
+                                              { "pageMissesPerSample", pages.misses / samples },
+                                              { "simulatedLines", (int) lines.getCapacity() },
+                                              { "simulatedPages", (int) pages.getCapacity() } }),
+                            blockSize, (int) paths.size(), [&]
+                            {
+                                float sum = 0.0f;
+                                sweepEllipses (paths, blockSize, [&] (float x, float y) { sum += plane.getInterpolated (x, y); });
+                                sink = sum;
+                            });
+
+                std::cout << "    simulated misses per sample: "
+                          << juce::String (lines.misses / samples, 3) << " lines, "
+                          << juce::String (pages.misses / samples, 3) << " pages" << std::endl;
+            }
+        }
+    }
+
+    void benchmarkVoices (BenchmarkRunner& runner)
+    {
+        constexpr int blockSize = 512;
+        const int voiceCounts[] { 1, 2, 4, 8, 12 };
+        const ModulationConfig configs[] { modulationConfigs[0], modulationConfigs[3] };
+
+        auto getCaseName = [] (const ModulationConfig& config, int numVoices)
+        {
+            return "voice/" + juce::String (config.name) + "/" + juce::String (numVoices);
+        };
+
+        bool isNeeded = false;
+
+        for (const auto& config : configs)
+            for (auto numVoices : voiceCounts)
+                isNeeded = isNeeded || runner.isSelected (getCaseName (config, numVoices));
+
+        if (! isNeeded)
+            return;
+
+        ImageInEngine engine;
+        engine.imageBuffer.setImage (createTestImage (1024));
+        engine.imageBuffer.dispatchPendingMessages();
+        engine.prepare (sampleRate, blockSize, 2);
+        fillModulators (engine.lfoBuffer);
+
+        for (const auto& config : configs)
+        {
+            for (auto numVoices : voiceCounts)
+            {
+                engine.globalParams.ellipses[0] = makeEllipseParameters (config);
+                engine.globalParams.modulationInterval = config.interval;
+                engine.globalParams.polyphony = numVoices;
+
+                MapSynthesiser synth;
+                synth.addSound (new SynthSound());
+
+                for (int i = 0; i < numVoices; ++i)
+                {
+                    auto* voice = new SynthVoice (engine, i, 0);
+                    voice->rebuildReaders ({ ReaderBase::Type::Ellipse });
+                    voice->prepare (blockSize, 2);
+                    synth.addVoice (voice);
+                }
+
+                synth.setPolyphony (numVoices);
+                synth.setCurrentPlaybackSampleRate (sampleRate);
+
+                for (int i = 0; i < numVoices; ++i)
+                    synth.noteOn (1, 48 + 3 * i, 0.8f);
+
+                juce::AudioBuffer<float> output (2, blockSize);
+                const juce::MidiBuffer noMidi;
+
+                runner.run (getCaseName (config, numVoices),
+                            makeParameters ({ { "numVoices", numVoices }, { "blockSize", blockSize }, { "modulation", config.name } }),
+                            blockSize, numVoices, [&]
+                            {
+                                juce::ScopedNoDenormals noDenormals;
+                                output.clear();
+                                synth.renderNextBlock (output, noMidi, 0, blockSize);
+                            });
+            }
+        }
+    }
+
+    void benchmarkModulators (BenchmarkRunner& runner)
+    {
+        constexpr int blockSize = 512;
+        std::vector<float> output ((size_t) blockSize);
+
+        for (int waveform = 0; waveform < lfoWaveformChoices.size(); ++waveform)
+        {
+            LFO lfo;
+            lfo.prepareToPlay (sampleRate);
+            lfo.setWaveform ((LFO::Waveform) waveform);
+            lfo.setFrequency (3.0f);
+
+            runner.run ("lfo/" + lfoWaveformChoices[waveform], makeParameters ({ { "waveform", lfoWaveformChoices[waveform] } }),
+                        blockSize, 1, [&]
+                        {
+                            for (auto& sample : output)
+                                sample = lfo.process();
+                        });
+        }
+
+        ADSR adsr;
+        adsr.prepareToPlay (sampleRate);
+        adsr.setParameters ({ 0.01f, 0.2f, 0.7f, 0.4f });
+        adsr.noteOn();
+
+        runner.run ("adsr/process", {}, blockSize, 1, [&]
+                    {
+                        for (auto& sample : output)
+                            sample = adsr.process();
+                    });
+
+        runner.run ("adsr/advance", {}, blockSize, 1, [&] { adsr.advance (blockSize); });
+    }
+
+    /** Exposes the filter stage of a reader on its own. */
+    struct FilterProbe : public EllipseReader
+    {
+        using ReaderBase::applyFilter;
+    };
+
+    void benchmarkFilter (BenchmarkRunner& runner)
+    {
+        constexpr int blockSize = 512;
+
+        struct FilterConfig { const char* name; FilterParameters params; };
+
+        const FilterConfig configs[]
+        {
+            { "bypassed",  { (int) FilterType::Lowpass,  20000.0f, 1.0f, 0.0f, 0, 0.0f, 0 } },
+            { "lowpass",   { (int) FilterType::Lowpass,  1000.0f,  4.0f, 0.0f, 0, 0.0f, 0 } },
+            { "highpass",  { (int) FilterType::Highpass, 300.0f,   2.0f, 0.0f, 0, 0.0f, 0 } },
+            { "modulated", { (int) FilterType::Lowpass,  1000.0f,  4.0f, 0.5f, 0, 0.3f, 1 } },
+        };
+
+        juce::AudioBuffer<float> modulators (2, blockSize);
+        fillModulators (modulators);
+
+        juce::AudioBuffer<float> samples (1, blockSize);
+        juce::Random random (1);
+
+        for (const auto& config : configs)
+        {
+            FilterProbe probe;
+            probe.prepareToPlay (sampleRate);
+            probe.updateFilterParameters (config.params);
+
+            runner.run ("filter/" + juce::String (config.name), makeParameters ({ { "mode", config.name } }),
+                        blockSize, 1, [&]
+                        {
+                            juce::ScopedNoDenormals noDenormals;
+                            auto* data = samples.getWritePointer (0);
+
+                            for (int i = 0; i < blockSize; ++i)
+                                data[i] = random.nextFloat() * 2.0f - 1.0f;
+
+                            probe.applyFilter (data, modulators.getReadPointer (0), modulators.getReadPointer (1), blockSize);
+                        });
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args (argc, argv);
+
+    const auto filter = args.containsOption ("--filter") ? args.getValueForOption ("--filter") : juce::String();
+    const auto minSeconds = args.containsOption ("--min-time") ? args.getValueForOption ("--min-time").getDoubleValue() : 0.1;
+    const auto repetitions = args.containsOption ("--repetitions") ? args.getValueForOption ("--repetitions").getIntValue() : 3;
+    const bool quick = args.containsOption ("--quick");
+
+    BenchmarkRunner runner (minSeconds, repetitions, filter);
+
+    benchmarkReaders (runner, quick);
+    benchmarkPlaneLayouts (runner, quick);
+    benchmarkVoices (runner);
+    benchmarkModulators (runner);
+    benchmarkFilter (runner);
+
+    if (args.containsOption ("--json"))
+    {
+        const auto jsonFile = args.getFileForOption ("--json");
+
+        if (! jsonFile.replaceWithText (runner.toJson()))
+        {
+            std::cerr << "Cannot write " << jsonFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,361 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+// Golden-output check for the DSP: renders every factory preset, with its own
+// factory image, through a fixed MIDI sequence and compares the result with
+// reference renders recorded earlier.
+//
+//   GoldenRender --record <folder>
+//   GoldenRender --compare <folder> [--tolerances <file.json>] [--filter <text>]
+//
+// Record the references from a build known to be good, then compare after any
+// change to the kernels. Each preset is checked on its maximum absolute error,
+// its RMS error and the log-spectral distance between the two renders. The
+// limits come from tolerances.json, next to this tool's project and built into
+// it; --tolerances reads another file instead. Either may set them for all
+// presets or per preset:
+//
+//   { "default": { "maxAbs": 0.001 }, "DeepDive": { "spectralDb": 1.0 } }
+//
+// The exit code is 1 if any preset is over its tolerances or has no reference.
+
+#include <JuceHeader.h>
+#include "../../../Source/FactoryPresets.h"
+#include "../../../Source/FactoryImages.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr double lengthSeconds = 6.0;
+
+    /** A held chord, then a short line over it, then silence for the releases. */
+    juce::MidiMessageSequence createSequence()
+    {
+        juce::MidiMessageSequence sequence;
+
+        auto addNote = [&sequence] (int note, double start, double end, float velocity)
+        {
+            sequence.addEvent (juce::MidiMessage::noteOn (1, note, velocity), start);
+            sequence.addEvent (juce::MidiMessage::noteOff (1, note), end);
+        };
+
+        for (auto note : { 48, 55, 60, 64 })
+            addNote (note, 0.0, 2.5, 0.8f);
+
+        const int line[] { 67, 69, 72, 74, 76, 74 };
+
+        for (int i = 0; i < (int) std::size (line); ++i)
+            addNote (line[i], 2.5 + 0.25 * i, 2.5 + 0.25 * (i + 1), 0.6f + 0.05f * (float) i);
+
+        addNote (36, 2.5, 4.0, 1.0f);
+
+        sequence.updateMatchedPairs();
+        return sequence;
+    }
+
+    /** Renders one factory preset; the result is stereo, lengthSeconds long, or
+        empty if the preset or its image can't be read. */
+    juce::AudioBuffer<float> renderPreset (const FactoryPresets::Preset& preset)
+    {
+        EngineSettings settings;
+        const auto xml = juce::XmlDocument::parse (preset.data);
+
+        if (xml == nullptr || ! settings.loadFromXml (*xml))
+            return {};
+
+        ImageInEngine engine;
+
+        if (! ImageResourceHelper::loadFactoryImage (engine, settings.factoryImage))
+            return {};
+
+        // The preset's image is decoded in the background; wait for it and publish it now.
+        engine.imageLoader.waitForPendingLoads();
+
+        // At the plugin's tempo when the host has none
+        engine.prepare (sampleRate, blockSize, 2);
+        settings.applyTo (engine, 120.0);
+
+        const auto sequence = createSequence();
+        const int totalSamples = (int) (lengthSeconds * sampleRate);
+
+        juce::AudioBuffer<float> output (2, totalSamples);
+        juce::AudioBuffer<float> block (2, blockSize);
+        juce::MidiBuffer midi;
+        int nextEvent = 0;
+
+        juce::ScopedNoDenormals noDenormals;
+
+        for (int position = 0; position < totalSamples; position += blockSize)
+        {
+            const int numSamples = juce::jmin (blockSize, totalSamples - position);
+            midi.clear();
+
+            for (; nextEvent < sequence.getNumEvents(); ++nextEvent)
+            {
+                const auto& message = sequence.getEventPointer (nextEvent)->message;
+                const int eventSample = juce::roundToInt (message.getTimeStamp() * sampleRate);
+
+                if (eventSample >= position + numSamples)
+                    break;
+
+                midi.addEvent (message, eventSample - position);
+            }
+
+            block.setSize (2, numSamples, false, false, true);
+            engine.process (block, midi);
+
+            for (int channel = 0; channel < 2; ++channel)
+                output.copyFrom (channel, position, block, channel, 0, numSamples);
+        }
+
+        return output;
+    }
+
+    //==============================================================================
+    struct Metrics
+    {
+        double maxAbs = 0.0;
+        double rms = 0.0;
+        double spectralDb = 0.0; // mean log-spectral distance over the frames
+    };
+
+    /** Mean over the frames of the RMS difference, in dB, between the two magnitude spectra. */
+    double getSpectralDistance (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        constexpr int fftOrder = 12;
+        constexpr int fftSize = 1 << fftOrder;
+        constexpr int hopSize = fftSize / 2;
+        constexpr float floorDb = -120.0f; // below this, differences do not count
+
+        juce::dsp::FFT fft (fftOrder);
+        juce::dsp::WindowingFunction<float> window (fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> frameA ((size_t) fftSize * 2), frameB ((size_t) fftSize * 2);
+
+        const int numSamples = juce::jmin (a.getNumSamples(), b.getNumSamples());
+        double total = 0.0;
+        int numFrames = 0;
+
+        auto loadMonoFrame = [] (const juce::AudioBuffer<float>& source, int start, std::vector<float>& frame)
+        {
+            std::fill (frame.begin(), frame.end(), 0.0f);
+
+            for (int channel = 0; channel < source.getNumChannels(); ++channel)
+                juce::FloatVectorOperations::addWithMultiply (frame.data(), source.getReadPointer (channel, start),
+                                                              1.0f / (float) source.getNumChannels(), fftSize);
+        };
+
+        for (int start = 0; start + fftSize <= numSamples; start += hopSize)
+        {
+            loadMonoFrame (a, start, frameA);
+            loadMonoFrame (b, start, frameB);
+            window.multiplyWithWindowingTable (frameA.data(), (size_t) fftSize);
+            window.multiplyWithWindowingTable (frameB.data(), (size_t) fftSize);
+            fft.performFrequencyOnlyForwardTransform (frameA.data(), true);
+            fft.performFrequencyOnlyForwardTransform (frameB.data(), true);
+
+            double sumOfSquares = 0.0;
+
+            for (int bin = 0; bin <= fftSize / 2; ++bin)
+            {
+                const float dbA = juce::jmax (floorDb, juce::Decibels::gainToDecibels (frameA[(size_t) bin] / (float) fftSize, floorDb));
+                const float dbB = juce::jmax (floorDb, juce::Decibels::gainToDecibels (frameB[(size_t) bin] / (float) fftSize, floorDb));
+                sumOfSquares += juce::square ((double) (dbA - dbB));
+            }
+
+            total += std::sqrt (sumOfSquares / (double) (fftSize / 2 + 1));
+            ++numFrames;
+        }
+
+        return numFrames > 0 ? total / (double) numFrames : 0.0;
+    }
+
+    Metrics compare (const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference)
+    {
+        Metrics metrics;
+        const int numSamples = juce::jmin (rendered.getNumSamples(), reference.getNumSamples());
+        double sumOfSquares = 0.0;
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const auto* r = rendered.getReadPointer (channel);
+            const auto* g = reference.getReadPointer (channel);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double error = (double) r[i] - (double) g[i];
+                metrics.maxAbs = juce::jmax (metrics.maxAbs, std::abs (error));
+                sumOfSquares += error * error;
+            }
+        }
+
+        metrics.rms = numSamples > 0 ? std::sqrt (sumOfSquares / (2.0 * numSamples)) : 0.0;
+        metrics.spectralDb = getSpectralDistance (rendered, reference);
+
+        // A render of the wrong length is a failure whatever the samples say.
+        if (rendered.getNumSamples() != reference.getNumSamples())
+            metrics.maxAbs = std::numeric_limits<double>::infinity();
+
+        return metrics;
+    }
+
+    Metrics getTolerances (const juce::var& config, const juce::String& presetName)
+    {
+        Metrics tolerances { 1.0e-3, 1.0e-4, 0.5 };
+
+        for (const auto& section : { juce::String ("default"), presetName })
+        {
+            const auto& values = config[juce::Identifier (section)];
+
+            if (values.hasProperty ("maxAbs"))      tolerances.maxAbs = values["maxAbs"];
+            if (values.hasProperty ("rms"))         tolerances.rms = values["rms"];
+            if (values.hasProperty ("spectralDb"))  tolerances.spectralDb = values["spectralDb"];
+        }
+
+        return tolerances;
+    }
+
+    //==============================================================================
+    bool writeWav (const juce::File& file, const juce::AudioBuffer<float>& buffer)
+    {
+        file.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream (file.createOutputStream());
+
+        if (stream == nullptr)
+            return false;
+
+        // 32-bit float, so the reference is exactly what was rendered.
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), sampleRate,
+                                                                                    (unsigned int) buffer.getNumChannels(),
+                                                                                    32, {}, 0));
+        if (writer == nullptr)
+            return false;
+
+        stream.release(); // now owned by the writer
+        return writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    bool readWav (const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatReader> reader (wavFormat.createReaderFor (file.createInputStream().release(), true));
+
+        if (reader == nullptr || reader->numChannels != 2)
+            return false;
+
+        buffer.setSize (2, (int) reader->lengthInSamples);
+        return reader->read (&buffer, 0, (int) reader->lengthInSamples, 0, true, true);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args (argc, argv);
+    const bool recording = args.containsOption ("--record");
+
+    if (! recording && ! args.containsOption ("--compare"))
+    {
+        std::cout << "Usage: GoldenRender --record <folder>" << std::endl
+                  << "       GoldenRender --compare <folder> [--tolerances <file.json>] [--filter <text>]" << std::endl;
+        return 1;
+    }
+
+    const auto folder = args.getFileForOption (recording ? "--record" : "--compare");
+    const auto filter = args.containsOption ("--filter") ? args.getValueForOption ("--filter") : juce::String();
+
+    auto tolerancesConfig = juce::JSON::parse (juce::String::fromUTF8 (BinaryData::tolerances_json, BinaryData::tolerances_jsonSize));
+
+    if (args.containsOption ("--tolerances"))
+    {
+        const auto tolerancesFile = args.getFileForOption ("--tolerances");
+        tolerancesConfig = juce::JSON::parse (tolerancesFile);
+
+        if (! tolerancesConfig.isObject())
+        {
+            std::cerr << "Cannot read tolerances from " << tolerancesFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    if (recording && ! folder.createDirectory())
+    {
+        std::cerr << "Cannot create " << folder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    int numFailures = 0;
+
+    for (const auto& preset : FactoryPresets::getAvailablePresets())
+    {
+        const auto& presetName = preset.name;
+
+        if (filter.isNotEmpty() && ! presetName.containsIgnoreCase (filter))
+            continue;
+
+        const auto referenceFile = folder.getChildFile (presetName.removeCharacters (" ") + ".wav");
+        const auto rendered = renderPreset (preset);
+
+        if (rendered.getNumSamples() == 0)
+        {
+            std::cout << "FAIL " << presetName << ": cannot read the preset or its image" << std::endl;
+            ++numFailures;
+            continue;
+        }
+
+        if (recording)
+        {
+            if (! writeWav (referenceFile, rendered))
+            {
+                std::cerr << "Cannot write " << referenceFile.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            std::cout << "Recorded " << presetName << std::endl;
+            continue;
+        }
+
+        juce::AudioBuffer<float> reference;
+
+        if (! readWav (referenceFile, reference))
+        {
+            std::cout << "FAIL " << presetName << ": no reference at " << referenceFile.getFullPathName() << std::endl;
+            ++numFailures;
+            continue;
+        }
+
+        const auto metrics = compare (rendered, reference);
+        const auto tolerances = getTolerances (tolerancesConfig, presetName);
+        const bool passed = metrics.maxAbs <= tolerances.maxAbs
+                         && metrics.rms <= tolerances.rms
+                         && metrics.spectralDb <= tolerances.spectralDb;
+
+        if (! passed)
+            ++numFailures;
+
+        std::cout << (passed ? "ok   " : "FAIL ") << presetName.paddedRight (' ', 24)
+                  << " max abs " << juce::String (metrics.maxAbs, 6) << " (" << juce::String (tolerances.maxAbs, 6) << ")"
+                  << "  rms " << juce::String (metrics.rms, 7) << " (" << juce::String (tolerances.rms, 7) << ")"
+                  << "  spectral " << juce::String (metrics.spectralDb, 3) << " dB (" << juce::String (tolerances.spectralDb, 3) << ")"
+                  << std::endl;
+    }
+
+    if (! recording)
+        std::cout << (numFailures == 0 ? "All presets match" : juce::String (numFailures) + " preset(s) differ") << std::endl;
+
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#!/bin/sh
+# ==============================================================================
+#
+#   check_against.sh
+#   Created: 17 Oct 2026 10:00:00am
+#   Author:  Olivier Doaré
+#
+#   Part of Image-In project
+#
+#   Licenced under the LGPLv3
+#
+# ==============================================================================
+#
+# Records golden references with GoldenRender built from a known-good commit,
+# then compares the working tree against them. This is the step CI runs.
+#
+#   Tools/GoldenRender/check_against.sh [<known-good-commit>] [--filter <text>]
+#
+# The commit defaults to main and must contain Tools/GoldenRender. JUCE must
+# sit next to the repository (../JUCE), as the Projucer projects expect, and
+# Projucer must be on the PATH or named by $PROJUCER. References are kept in
+# $GOLDEN_REFERENCES (by default build/golden/<commit>) and reused as long as
+# the known-good commit does not change.
+
+set -eu
+
+projucer="${PROJUCER:-Projucer}"
+repo="$(git -C "$(dirname "$0")" rev-parse --show-toplevel)"
+
+baseline=main
+if [ $# -gt 0 ] && [ "$1" != "--filter" ]; then
+    baseline="$1"
+    shift
+fi
+
+commit="$(git -C "$repo" rev-parse --verify "$baseline^{commit}")"
+references="${GOLDEN_REFERENCES:-$repo/build/golden/$commit}"
+
+build_tool()
+{
+    "$projucer" --resave "$1/Tools/GoldenRender/GoldenRender.jucer"
+    make -C "$1/Tools/GoldenRender/Builds/LinuxMakefile" CONFIG=Release -j"$(nproc)"
+}
+
+tool()
+{
+    echo "$1/Tools/GoldenRender/Builds/LinuxMakefile/build/GoldenRender"
+}
+
+if [ ! -d "$references" ]; then
+    # The worktree sits next to the repository so that ../JUCE resolves in it too.
+    worktree="$(dirname "$repo")/Image-In-golden-$commit"
+    trap 'git -C "$repo" worktree remove --force "$worktree"' EXIT
+
+    git -C "$repo" worktree add --detach "$worktree" "$commit"
+    build_tool "$worktree"
+    # Record aside first, so that a failed run is not mistaken for references.
+    rm -rf "$references.partial"
+    "$(tool "$worktree")" --record "$references.partial"
+    mv "$references.partial" "$references"
+fi
+
+build_tool "$repo"
+"$(tool "$repo")" --compare "$references" "$@"
@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 10:00:00am
+    Author:  Olivier Doaré
+
+    Part of Image-In project
+
+    Licenced under the LGPLv3
+
+  ==============================================================================
+*/
+
+// Headless renderer: plays MIDI files through an ImageInEngine and writes WAV
+// files, without the plugin, an editor or an audio device.
+//
+//   OfflineRender --preset <file.xml | factory preset name> [--image <file>]
+//                 [--out <folder>] [--rate 48000] [--block 512] [--tail 5]
+//                 [--jobs <n>] <file.mid> [<file.mid> ...]
+//
+// Each MIDI file is one job, rendered by its own engine to
+// <folder>/<name>.wav. Jobs run in parallel, one per core by default, and the
+// realtime factor of each job and of the whole batch is printed at the end.
+
+#include <JuceHeader.h>
+#include "../../../Source/FactoryPresets.h"
+#include "../../../Source/FactoryImages.h"
+
+namespace
+{
+    struct Settings
+    {
+        juce::String preset;
+        juce::File image;
+        juce::File outputFolder { juce::File::getCurrentWorkingDirectory() };
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        double tailSeconds = ImageInEngine::tailLengthSeconds;
+        int numJobs = juce::SystemStats::getNumCpus();
+        juce::Array<juce::File> midiFiles;
+    };
+
+    void printUsage()
+    {
+        std::cout << "Usage: OfflineRender --preset <file.xml | factory preset name> [--image <file>]" << std::endl
+                  << "                     [--out <folder>] [--rate 48000] [--block 512] [--tail 5]" << std::endl
+                  << "                     [--jobs <n>] <file.mid> [<file.mid> ...]" << std::endl;
+    }
+
+    bool parseArguments (const juce::ArgumentList& args, Settings& settings)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+            const bool hasValue = i + 1 < args.size();
+
+            if (arg.isLongOption ("preset") && hasValue)        settings.preset = args[++i].text;
+            else if (arg.isLongOption ("image") && hasValue)    settings.image = args[++i].resolveAsFile();
+            else if (arg.isLongOption ("out") && hasValue)      settings.outputFolder = args[++i].resolveAsFile();
+            else if (arg.isLongOption ("rate") && hasValue)     settings.sampleRate = args[++i].text.getDoubleValue();
+            else if (arg.isLongOption ("block") && hasValue)    settings.blockSize = args[++i].text.getIntValue();
+            else if (arg.isLongOption ("tail") && hasValue)     settings.tailSeconds = args[++i].text.getDoubleValue();
+            else if (arg.isLongOption ("jobs") && hasValue)     settings.numJobs = args[++i].text.getIntValue();
+            else if (! arg.isOption())                          settings.midiFiles.add (arg.resolveAsFile());
+            else
+            {
+                std::cerr << "Unknown or incomplete option: " << arg.text << std::endl;
+                return false;
+            }
+        }
+
+        if (settings.preset.isEmpty() || settings.midiFiles.isEmpty())
+            return false;
+
+        if (settings.sampleRate <= 0.0 || settings.blockSize <= 0)
+        {
+            std::cerr << "Sample rate and block size must be positive" << std::endl;
+            return false;
+        }
+
+        settings.numJobs = juce::jmax (1, settings.numJobs);
+        settings.tailSeconds = juce::jmax (0.0, settings.tailSeconds);
+        return true;
+    }
+
+    /** Reads a preset file, or a factory preset by name. */
+    bool loadPreset (EngineSettings& engineSettings, const juce::String& preset)
+    {
+        const juce::File presetFile = juce::File::getCurrentWorkingDirectory().getChildFile (preset);
+        std::unique_ptr<juce::XmlElement> xml;
+
+        if (presetFile.existsAsFile())
+        {
+            xml = juce::XmlDocument::parse (presetFile);
+        }
+        else
+        {
+            // Not a file: look it up among the factory presets.
+            for (const auto& factoryPreset : FactoryPresets::getAvailablePresets())
+                if (factoryPreset.name.equalsIgnoreCase (preset))
+                    xml = juce::XmlDocument::parse (factoryPreset.data);
+        }
+
+        return xml != nullptr && engineSettings.loadFromXml (*xml);
+    }
+
+    //==============================================================================
+    /** Renders one MIDI file to one WAV file on its own engine. */
+    class RenderJob : public juce::ThreadPoolJob
+    {
+    public:
+        RenderJob (const juce::File& midiFileToRender, const juce::File& outputFileToWrite)
+            : juce::ThreadPoolJob (midiFileToRender.getFileName()),
+              midiFile (midiFileToRender),
+              outputFile (outputFileToWrite)
+        {
+        }
+
+        /** Loads everything and opens the output. Called on the message thread,
+            where the engine has to be created and its image published. */
+        bool prepare (const Settings& settings)
+        {
+            if (! readMidiFile())
+                return fail ("cannot read " + midiFile.getFullPathName());
+
+            engine = std::make_unique<ImageInEngine>();
+            EngineSettings engineSettings;
+
+            if (! loadPreset (engineSettings, settings.preset))
+                return fail ("cannot load preset " + settings.preset);
+
+            // The preset's image, as the plugin would load it
+            if (engineSettings.factoryImage > 0 && ! ImageResourceHelper::loadFactoryImage (*engine, engineSettings.factoryImage))
+                return fail ("preset " + settings.preset + " has no factory image " + juce::String (engineSettings.factoryImage));
+
+            if (engineSettings.imagePath.isNotEmpty())
+                engine->imageLoader.loadAsync (juce::File (engineSettings.imagePath));
+
+            // Images are decoded in the background; don't let one land on top of --image.
+            engine->imageLoader.waitForPendingLoads();
+
+            if (settings.image != juce::File() && ! engine->imageBuffer.setImage (settings.image))
+                return fail ("cannot load image " + settings.image.getFullPathName());
+
+            // The bitmap is normally rebuilt from a change message; do it now so
+            // the first block already reads the right image.
+            engine->imageBuffer.dispatchPendingMessages();
+
+            sampleRate = settings.sampleRate;
+            blockSize = settings.blockSize;
+            lengthInSamples = (juce::int64) std::ceil ((events.getEndTime() + settings.tailSeconds) * sampleRate);
+
+            // Set once: the preset doesn't change during the render. Tempo-synced
+            // LFOs follow the first tempo of the MIDI file.
+            engine->prepare (sampleRate, blockSize, 2);
+            engineSettings.applyTo (*engine, bpm);
+
+            outputFile.deleteFile();
+            std::unique_ptr<juce::OutputStream> stream (outputFile.createOutputStream());
+
+            if (stream == nullptr)
+                return fail ("cannot write " + outputFile.getFullPathName());
+
+            juce::WavAudioFormat wavFormat;
+            writer.reset (wavFormat.createWriterFor (stream.get(), sampleRate, 2, 24, {}, 0));
+
+            if (writer == nullptr)
+                return fail ("cannot create a WAV writer for " + outputFile.getFullPathName());
+
+            stream.release(); // now owned by the writer
+            return true;
+        }
+
+        JobStatus runJob() override
+        {
+            juce::ScopedNoDenormals noDenormals;
+            juce::AudioBuffer<float> buffer (2, blockSize);
+            juce::MidiBuffer midi;
+            int nextEvent = 0;
+
+            for (juce::int64 position = 0; position < lengthInSamples && ! shouldExit(); position += blockSize)
+            {
+                const int numSamples = (int) juce::jmin ((juce::int64) blockSize, lengthInSamples - position);
+                const double blockEnd = (double) (position + numSamples) / sampleRate;
+
+                midi.clear();
+
+                for (; nextEvent < events.getNumEvents(); ++nextEvent)
+                {
+                    const auto& message = events.getEventPointer (nextEvent)->message;
+
+                    if (message.getTimeStamp() >= blockEnd)
+                        break;
+
+                    const auto offset = juce::roundToInt (message.getTimeStamp() * sampleRate) - position;
+                    midi.addEvent (message, (int) juce::jlimit ((juce::int64) 0, (juce::int64) numSamples - 1, offset));
+                }
+
+                buffer.setSize (2, numSamples, false, false, true);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                engine->process (buffer, midi);
+                renderTicks += juce::Time::getHighResolutionTicks() - start;
+
+                writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+            }
+
+            writer.reset();
+            return jobHasFinished;
+        }
+
+        /** Seconds of audio written, divided by the seconds spent in the engine. */
+        double getRealtimeFactor() const
+        {
+            const double renderSeconds = juce::Time::highResolutionTicksToSeconds (renderTicks);
+            return renderSeconds > 0.0 ? getAudioSeconds() / renderSeconds : 0.0;
+        }
+
+        double getAudioSeconds() const   { return (double) lengthInSamples / sampleRate; }
+        const juce::String& getError() const { return error; }
+        const juce::File& getOutputFile() const { return outputFile; }
+
+    private:
+        bool readMidiFile()
+        {
+            juce::FileInputStream stream (midiFile);
+            juce::MidiFile file;
+
+            if (! stream.openedOk() || ! file.readFrom (stream))
+                return false;
+
+            // Tempo-synced LFOs follow the first tempo of the file; the event
+            // times below already account for every tempo change.
+            juce::MidiMessageSequence tempoEvents;
+            file.findAllTempoEvents (tempoEvents);
+
+            if (tempoEvents.getNumEvents() > 0)
+                bpm = 60.0 / tempoEvents.getEventPointer (0)->message.getTempoSecondsPerQuarterNote();
+
+            file.convertTimestampTicksToSeconds();
+
+            for (int track = 0; track < file.getNumTracks(); ++track)
+                events.addSequence (*file.getTrack (track), 0.0);
+
+            events.updateMatchedPairs();
+            return true;
+        }
+
+        bool fail (const juce::String& message)
+        {
+            error = message;
+            return false;
+        }
+
+        const juce::File midiFile, outputFile;
+        juce::MidiMessageSequence events;
+        double bpm = 120.0;
+
+        std::unique_ptr<ImageInEngine> engine;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        juce::int64 lengthInSamples = 0;
+        juce::int64 renderTicks = 0;
+        juce::String error;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderJob)
+    };
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    Settings settings;
+
+    if (! parseArguments (juce::ArgumentList (argc, argv), settings))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (! settings.outputFolder.createDirectory())
+    {
+        std::cerr << "Cannot create " << settings.outputFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    juce::OwnedArray<RenderJob> jobs;
+
+    for (const auto& midiFile : settings.midiFiles)
+    {
+        auto* job = jobs.add (new RenderJob (midiFile, settings.outputFolder.getChildFile (midiFile.getFileNameWithoutExtension() + ".wav")));
+
+        if (! job->prepare (settings))
+        {
+            std::cerr << "Error: " << job->getError() << std::endl;
+            return 1;
+        }
+    }
+
+    const auto batchStart = juce::Time::getHighResolutionTicks();
+
+    {
+        juce::ThreadPool pool (juce::jmin (settings.numJobs, jobs.size()));
+
+        for (auto* job : jobs)
+            pool.addJob (job, false);
+
+        for (auto* job : jobs)
+            pool.waitForJobToFinish (job, -1);
+    }
+
+    const double batchSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - batchStart);
+    double totalAudioSeconds = 0.0;
+
+    for (auto* job : jobs)
+    {
+        totalAudioSeconds += job->getAudioSeconds();
+        std::cout << job->getOutputFile().getFullPathName() << ": "
+                  << juce::String (job->getAudioSeconds(), 2) << " s, realtime x"
+                  << juce::String (job->getRealtimeFactor(), 1) << std::endl;
+    }
+
+    std::cout << "Total: " << juce::String (totalAudioSeconds, 2) << " s of audio in "
+              << juce::String (batchSeconds, 2) << " s, realtime x"
+              << juce::String (batchSeconds > 0.0 ? totalAudioSeconds / batchSeconds : 0.0, 1) << std::endl;
+
+    return 0;
+}